@@ -75,8 +75,8 @@ buf_=|  |text|rest|free|
 buf_ // points to buffered input, grows to fit long matches
 cur_ // current position in buf_ while matching text, cur_ = pos_ afterwards, can be changed by more()
 pos_ // position in buf_ to start the next match
-end_ // position in buf_ that is free to fill with more input
-max_ // allocated size of buf_, must ensure that max_ > end_ for text() to add a final \0
+end_ // position in buf_ that is free to fill with more input, buf_[end_] is a sentinel \0
+max_ // size of buf_ to fill, buf_ is allocated with one more byte for the sentinel \0 at buf_[end_]
 txt_ // buf_ + cur_ points to the match, 0-terminated
 len_ // length of the match
 chr_ // char located at txt_[len_] when txt_[len_] is set to \0, is \0 otherwise
@@ -299,11 +299,13 @@ class AbstractMatcher {
     {
       (void)grow(n + 1); // now attempt to fetch all (remaining) data to store in the buffer, +1 for a \0
       end_ += get(buf_, n);
+      buf_[end_] = '\0';
     }
     while (in.good()) // there is more to get while good(), e.g. via wrap()
     {
       (void)grow();
       end_ += get(buf_ + end_, max_ - end_);
+      buf_[end_] = '\0';
     }
     if (end_ == max_)
       (void)grow(1); // we need room for a final \0
@@ -651,7 +653,7 @@ class AbstractMatcher {
       if (end_ + blk_ >= max_)
         (void)grow();
       std::memmove(buf_ + 1, buf_, end_);
-      ++end_;
+      buf_[++end_] = '\0';
     }
     buf_[pos_] = c;
     cur_ = pos_;
@@ -673,6 +675,7 @@ class AbstractMatcher {
     while (true)
     {
       end_ += get(buf_ + end_, blk_ ? blk_ : max_ - end_);
+      buf_[end_] = '\0';
       if (pos_ < end_)
         return static_cast<unsigned char>(buf_[pos_]);
       DBGLOGN("peek(): EOF");
@@ -699,6 +702,7 @@ class AbstractMatcher {
       update();
       end_ -= pos_;
       std::memmove(buf_, buf_ + pos_, end_);
+      buf_[end_] = '\0';
     }
     txt_ = buf_;
     while (!eof_)
@@ -706,6 +710,7 @@ class AbstractMatcher {
       (void)grow();
       pos_ = end_;
       end_ += get(buf_ + end_, blk_ ? blk_ : max_ - end_);
+      buf_[end_] = '\0';
       if (pos_ == end_)
       {
         DBGLOGN("rest(): EOF");
@@ -880,9 +885,9 @@ class AbstractMatcher {
   {
     DBGLOG("AbstractMatcher::init(%s)", opt ? opt : "");
 #if defined(WITH_REALLOC)
-    buf_ = static_cast<char*>(std::malloc(max_ = 2 * Const::BLOCK));
+    buf_ = static_cast<char*>(std::malloc((max_ = 2 * Const::BLOCK) + 1));
 #else
-    buf_ = new char[max_ = 2 * Const::BLOCK];
+    buf_ = new char[(max_ = 2 * Const::BLOCK) + 1];
 #endif
     reset(opt);
   }
@@ -921,6 +926,7 @@ class AbstractMatcher {
       end_ -= gap;
       if (end_ > 0)
         std::memmove(buf_, txt_, end_);
+      buf_[end_] = '\0';
       txt_ = buf_;
     }
     else
@@ -938,16 +944,17 @@ class AbstractMatcher {
         pos_ -= gap;
         end_ -= gap;
 #if defined(WITH_REALLOC)
-        char *newbuf = static_cast<char*>(std::realloc(static_cast<void*>(buf_), max_));
+        char *newbuf = static_cast<char*>(std::realloc(static_cast<void*>(buf_), max_ + 1));
         if (newbuf != NULL)
           txt_ = buf_ = newbuf;
 #else
-        char *newbuf = new char[max_];
+        char *newbuf = new char[max_ + 1];
         if (end_ > 0)
           std::memcpy(newbuf, txt_, end_);
         delete[] buf_;
         txt_ = buf_ = newbuf;
 #endif
+        buf_[end_] = '\0';
       }
     }
     return true;
@@ -969,6 +976,7 @@ class AbstractMatcher {
     while (true)
     {
       end_ += get(buf_ + end_, blk_ ? blk_ : max_ - end_);
+      buf_[end_] = '\0';
       if (pos_ < end_)
         return static_cast<unsigned char>(buf_[pos_++]);
       DBGLOGN("get(): EOF");
@@ -982,6 +990,18 @@ class AbstractMatcher {
     }
 #endif
   }
+  /// Returns the next character read from the current input source, like AbstractMatcher::get(), but checks the end of the buffered input only when the sentinel \0 at AbstractMatcher::buf_[AbstractMatcher::end_] is read.
+  int get_sentinel()
+    /// @returns the character read (unsigned char 0..255) or EOF (-1).
+  {
+    int c = static_cast<unsigned char>(buf_[pos_++]);
+    if (c == '\0' && pos_ > end_)
+    {
+      --pos_;
+      return get();
+    }
+    return c;
+  }
   /// Reset the matched text by removing the terminating \0, which is needed to search for a new match.
   void reset_text()
   {
@@ -1005,7 +1025,7 @@ class AbstractMatcher {
   size_t      cap_; ///< nonzero capture index of an accepted match or zero
   size_t      cur_; ///< next position in AbstractMatcher::buf_ to assign to AbstractMatcher::txt_
   size_t      pos_; ///< position in AbstractMatcher::buf_ after AbstractMatcher::txt_
-  size_t      end_; ///< ending position of the input buffered in AbstractMatcher::buf_
+  size_t      end_; ///< ending position of the input buffered in AbstractMatcher::buf_, invariant: buf_[end_] == '\0' is a sentinel that every update of AbstractMatcher::buf_ and AbstractMatcher::end_ must restore, AbstractMatcher::get_sentinel() and the matcher's DFA loop rely on it
   size_t      max_; ///< total buffer size and max position + 1 to fill
   size_t      ind_; ///< current indent position
   size_t      blk_; ///< block size for block-based input reading, as set by AbstractMatcher::buffer
@@ -1030,6 +1050,7 @@ class AbstractMatcher {
     while (true)
     {
       end_ += get(buf_ + end_, blk_ ? blk_ : max_ - end_);
+      buf_[end_] = '\0';
       if (pos_ < end_)
         return static_cast<unsigned char>(buf_[pos_++]);
       DBGLOGN("get_more(): EOF");
@@ -1054,6 +1075,7 @@ class AbstractMatcher {
     while (true)
     {
       end_ += get(buf_ + end_, blk_ ? blk_ : max_ - end_);
+      buf_[end_] = '\0';
       if (pos_ < end_)
         return static_cast<unsigned char>(buf_[pos_]);
       DBGLOGN("peek_more(): EOF");
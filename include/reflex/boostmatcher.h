@@ -168,6 +168,7 @@ class BoostMatcher : public PatternMatcher<boost::regex> {
         if (grow()) // make sure we have enough storage to read input
           itr_ = fin_; // buffer shifting/growing invalidates iterator
         end_ += get(buf_ + end_, blk_ ? blk_ : max_ - end_);
+        buf_[end_] = '\0';
         DBGLOGN("Got more input pos = %zu end = %zu max = %zu", pos_, end_, max_);
       }
       if (pos_ == end_) // if pos_ is hitting the end_ then
@@ -64,6 +64,7 @@ class regex_error : public std::runtime_error {
   static const regex_error_type invalid_syntax       = 13; ///< invalid regex syntax
   static const regex_error_type exceeds_limits       = 14; ///< regex exceeds complexity limits (reflex::Pattern class only)
   static const regex_error_type undefined_name       = 15; ///< undefined macro name (reflex tool only)
+  static const regex_error_type exceeds_budget       = 16; ///< pattern construction exceeds its budget or is cancelled (reflex::Pattern class only)
   /// Construct regex error info.
   regex_error(
       regex_error_type code,
@@ -173,7 +173,24 @@ class Matcher : public PatternMatcher<reflex::Pattern> {
   /// FSM code CHAR.
   inline int FSM_CHAR()
   {
-    return get();
+    return get_sentinel();
+  }
+  /// FSM code SKIP the run of bytes that loop to a state up to the next exit byte, returns the last byte skipped or c1.
+  inline int FSM_SKIP(int c1, const Pattern::Skip& skip)
+  {
+    while (true)
+    {
+      const unsigned char *b = reinterpret_cast<const unsigned char*>(buf_);
+      const unsigned char *s = b + pos_;
+      const unsigned char *t = skip.find(s, b + end_);
+      if (t > s)
+      {
+        c1 = t[-1];
+        pos_ = t - b;
+      }
+      if (pos_ < end_ || peek() == EOF)
+        return c1;
+    }
   }
   /// FSM code HALT.
   inline void FSM_HALT(int c1)
@@ -325,6 +342,18 @@ class Matcher : public PatternMatcher<reflex::Pattern> {
   virtual size_t match(Method method) ///< Const::SCAN, Const::FIND, Const::SPLIT, or Const::MATCH
     /// @returns nonzero if input matched the pattern.
     ;
+  /// Advance to the first position in the input where a match may begin, using the unanchored search DFA of the pattern.
+  bool advance(size_t& fnd) ///< set to the number of chars up to the end of the first match found
+    /// @returns true if a match is ahead, false if no match is possible and the input was consumed.
+    ;
+  /// Skip input to the window of the next needle string in the input that all matches contain, as predicted by the pattern.
+  bool skip_needle(size_t& nxt) ///< set to the number of chars up to the needle found plus one
+    /// @returns true if a needle was found, false when EOF was reached.
+    ;
+  /// Skip input to the next char or prefix string that may begin a match, as predicted by the pattern.
+  bool skip()
+    /// @returns true if a char that may begin a match was found, false when EOF was reached.
+    ;
   /// Update indentation column counter for indent() and dedent().
   void newline(size_t& col) ///< indent column counter
   {
@@ -44,11 +44,14 @@
 #include <reflex/ranges.h>
 #include <reflex/setop.h>
 #include <cctype>
+#include <cstddef>
 #include <cstring>
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <list>
 #include <map>
+#include <new>
 #include <set>
 #include <vector>
 
@@ -63,19 +66,84 @@ namespace reflex {
 class Pattern {
   friend class Matcher; ///< permit access by the reflex::Matcher engine
  public:
-  typedef uint16_t Index;  ///< index into opcodes array Pattern::opc_ and subpattern indexing
+  typedef uint32_t Index;  ///< index into opcodes array Pattern::opc_ and subpattern indexing
   typedef uint32_t Opcode; ///< 32 bit opcode word
   typedef void (*FSM)(class Matcher&); ///< function pointer to FSM code
   /// Common constants.
   enum Const {
-    IMAX = 0xFFFF, ///< max index, also serves as a marker
+    IMAX = 0xFFFF,   ///< max index, also serves as a marker
+    LONG = 0xFFFE,   ///< marks a GOTO opcode with its long index stored in the next opcode word
+    LMAX = 0x7EFFFF, ///< max long index
+  };
+  /// Resource budget of a pattern construction, to bound the work spent on untrusted regexes, a limit of zero is unbounded.
+  struct Budget {
+    Budget(
+        size_t states = 0,
+        size_t bytes  = 0,
+        float  ms     = 0.0)
+      :
+        states(states),
+        bytes(bytes),
+        ms(ms),
+        stop(0)
+    { }
+    /// Cancel the pattern construction, which may be called by another thread.
+    void cancel()
+    {
+#if defined(__GNUC__)
+      __atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+#else
+      stop = 1;
+#endif
+    }
+    /// Check if the pattern construction is cancelled.
+    bool cancelled() const
+      /// @returns true if cancelled.
+    {
+#if defined(__GNUC__)
+      return __atomic_load_n(&stop, __ATOMIC_ACQUIRE) != 0;
+#else
+      return stop != 0;
+#endif
+    }
+    size_t       states; ///< max number of DFA states constructed, or 0
+    size_t       bytes;  ///< max number of bytes allocated to construct the DFA, or 0
+    float        ms;     ///< max ms elapsed time to construct the DFA, or 0.0
+    volatile int stop;   ///< nonzero when cancelled
+  };
+  /// Exit bytes of a DFA state that loops to itself on most bytes, the matcher skips a run of bytes up to the next exit byte at once.
+  struct Skip {
+    /// Returns a pointer to the first exit byte in the range [s,e), or e when none.
+    const unsigned char *find(
+        const unsigned char *s,  ///< points to the first byte to check
+        const unsigned char *e)  ///< points to the end of the range
+      const;
+    Index   jump;    ///< index of the first jump of the decoded state, zero in generated code
+    Index   len;     ///< number of exit bytes 1 to 4 in chr[], or 0 when there are more exit bytes
+    uint8_t chr[4];  ///< the exit bytes when len > 0
+    uint8_t bit[32]; ///< bitmap of the exit bytes, bit c%8 of bit[c/8] is set when byte c exits the loop
   };
   /// Construct an unset pattern.
   explicit Pattern()
     :
       opc_(NULL),
       nop_(0),
-      fsm_(NULL)
+      fsm_(NULL),
+      lzy_(NULL),
+      bgt_(NULL),
+      gov_(NULL),
+      fop_(NULL),
+      nfo_(0),
+      rop_(NULL),
+      nro_(0),
+      dns_(NULL),
+      ncl_(0),
+      mem_(NULL),
+      nme_(0),
+      fno_(0),
+      nmn_(0),
+      nmx_(0),
+      nnl_(false)
   { }
   /// Construct a pattern object given a regex string.
   explicit Pattern(
@@ -84,7 +152,18 @@ class Pattern {
     :
       rex_(regex),
       opc_(NULL),
-      fsm_(NULL)
+      fsm_(NULL),
+      lzy_(NULL),
+      bgt_(NULL),
+      gov_(NULL),
+      fop_(NULL),
+      nfo_(0),
+      rop_(NULL),
+      nro_(0),
+      dns_(NULL),
+      ncl_(0),
+      mem_(NULL),
+      nme_(0)
   {
     init(options);
   }
@@ -95,7 +174,18 @@ class Pattern {
     :
       rex_(regex),
       opc_(NULL),
-      fsm_(NULL)
+      fsm_(NULL),
+      lzy_(NULL),
+      bgt_(NULL),
+      gov_(NULL),
+      fop_(NULL),
+      nfo_(0),
+      rop_(NULL),
+      nro_(0),
+      dns_(NULL),
+      ncl_(0),
+      mem_(NULL),
+      nme_(0)
   {
     init(options.c_str());
   }
@@ -106,7 +196,18 @@ class Pattern {
     :
       rex_(regex),
       opc_(NULL),
-      fsm_(NULL)
+      fsm_(NULL),
+      lzy_(NULL),
+      bgt_(NULL),
+      gov_(NULL),
+      fop_(NULL),
+      nfo_(0),
+      rop_(NULL),
+      nro_(0),
+      dns_(NULL),
+      ncl_(0),
+      mem_(NULL),
+      nme_(0)
   {
     init(options);
   }
@@ -117,7 +218,18 @@ class Pattern {
     :
       rex_(regex),
       opc_(NULL),
-      fsm_(NULL)
+      fsm_(NULL),
+      lzy_(NULL),
+      bgt_(NULL),
+      gov_(NULL),
+      fop_(NULL),
+      nfo_(0),
+      rop_(NULL),
+      nro_(0),
+      dns_(NULL),
+      ncl_(0),
+      mem_(NULL),
+      nme_(0)
   {
     init(options.c_str());
   }
@@ -126,7 +238,18 @@ class Pattern {
     :
       opc_(code),
       nop_(0),
-      fsm_(NULL)
+      fsm_(NULL),
+      lzy_(NULL),
+      bgt_(NULL),
+      gov_(NULL),
+      fop_(NULL),
+      nfo_(0),
+      rop_(NULL),
+      nro_(0),
+      dns_(NULL),
+      ncl_(0),
+      mem_(NULL),
+      nme_(0)
   {
     init(NULL);
   }
@@ -135,7 +258,18 @@ class Pattern {
     :
       opc_(NULL),
       nop_(0),
-      fsm_(fsm)
+      fsm_(fsm),
+      lzy_(NULL),
+      bgt_(NULL),
+      gov_(NULL),
+      fop_(NULL),
+      nfo_(0),
+      rop_(NULL),
+      nro_(0),
+      dns_(NULL),
+      ncl_(0),
+      mem_(NULL),
+      nme_(0)
   {
     init(NULL);
   }
@@ -148,11 +282,55 @@ class Pattern {
   void clear()
   {
     rex_.clear();
+    if (mem_)
+    {
+      // the opcode tables point into the memory-mapped file of a loaded pattern
+      opc_ = NULL;
+      nop_ = 0;
+      fop_ = NULL;
+      rop_ = NULL;
+      dns_ = NULL;
+      unmap();
+    }
+    if (lzy_)
+    {
+      Arena *arena = lzy_->arena;
+      delete lzy_;
+      delete arena;
+      lzy_ = NULL;
+      opc_ = NULL;
+      nop_ = 0;
+    }
     if (nop_ && opc_)
       delete[] opc_;
     opc_ = NULL;
     nop_ = 0;
     fsm_ = NULL;
+    if (fop_)
+      delete[] fop_;
+    fop_ = NULL;
+    nfo_ = 0;
+    if (rop_)
+      delete[] rop_;
+    rop_ = NULL;
+    nro_ = 0;
+    if (dns_)
+      delete[] dns_;
+    dns_ = NULL;
+    ncl_ = 0;
+    hop_.clear();
+    jmp_.clear();
+    hds_.clear();
+    skp_.clear();
+    pre_.clear();
+    fno_ = 0;
+    ndl_.clear();
+  }
+  /// Set the resource budget of the next construction by assign(), a regex_error::exceeds_budget is thrown when the budget is exceeded or cancelled.
+  Pattern& budget(Budget *budget)
+  {
+    bgt_ = budget;
+    return *this;
   }
   /// Assign a (new) pattern.
   Pattern&  assign(
@@ -210,12 +388,25 @@ class Pattern {
     end_ = pattern.end_;
     acc_ = pattern.acc_;
     vno_ = pattern.vno_;
+    uno_ = pattern.uno_;
     eno_ = pattern.eno_;
     pms_ = pattern.pms_;
     vms_ = pattern.vms_;
     ems_ = pattern.ems_;
     wms_ = pattern.wms_;
-    if (pattern.nop_ && pattern.opc_)
+    if (pattern.lzy_)
+    {
+      // parse the regex again to allocate the positions in the arena of this pattern
+      Arena *arena = new Arena;
+      Arena::Scope scope(arena);
+      lzy_ = new Lazy(pattern.lzy_->max, arena);
+      end_.clear();
+      parse(lzy_->startpos, lzy_->followpos, lzy_->modifiers, lzy_->lookahead);
+      compile_alphabet(lzy_->followpos, lzy_->modifiers, lzy_->alphabet);
+      opc_ = lzy_->code;
+      lazy_flush();
+    }
+    else if (pattern.nop_ && pattern.opc_)
     {
       nop_ = pattern.nop_;
       Opcode *code = new Opcode[nop_];
@@ -227,6 +418,44 @@ class Pattern {
     {
       fsm_ = pattern.fsm_;
     }
+    if (pattern.fop_)
+    {
+      nfo_ = pattern.nfo_;
+      Opcode *code = new Opcode[nfo_];
+      for (Index i = 0; i < nfo_; ++i)
+        code[i] = pattern.fop_[i];
+      fop_ = code;
+    }
+    if (pattern.rop_)
+    {
+      nro_ = pattern.nro_;
+      Opcode *code = new Opcode[nro_];
+      for (Index i = 0; i < nro_; ++i)
+        code[i] = pattern.rop_[i];
+      rop_ = code;
+    }
+    if (pattern.dns_)
+    {
+      ncl_ = pattern.ncl_;
+      size_t n = pattern.nds_ * ncl_;
+      Index *table = new Index[n];
+      for (size_t i = 0; i < n; ++i)
+        table[i] = pattern.dns_[i];
+      dns_ = table;
+      nds_ = pattern.nds_;
+      std::memcpy(cls_, pattern.cls_, sizeof(cls_));
+    }
+    hop_ = pattern.hop_;
+    jmp_ = pattern.jmp_;
+    hds_ = pattern.hds_;
+    skp_ = pattern.skp_;
+    pre_ = pattern.pre_;
+    std::memcpy(fst_, pattern.fst_, sizeof(fst_));
+    fno_ = pattern.fno_;
+    ndl_ = pattern.ndl_;
+    nmn_ = pattern.nmn_;
+    nmx_ = pattern.nmx_;
+    nnl_ = pattern.nnl_;
     return *this;
   }
   /// Assign a (new) pattern.
@@ -255,6 +484,14 @@ class Pattern {
   {
     return static_cast<Index>(end_.size());
   }
+  /// Save the compiled pattern to a binary file, which is loaded with load() and reused by Pattern option `c=dir;`.
+  bool save(const char *filename) const
+    /// @returns true if saved, false when the file cannot be written or this pattern has no opcode table of its own.
+    ;
+  /// Load a compiled pattern saved to a binary file with save(), the file is memory-mapped when supported.
+  bool load(const char *filename)
+    /// @returns true if loaded, false when the file cannot be read or is not compatible.
+    ;
   /// Get subpattern regex of this pattern object or the whole regex with index 0.
   const std::string operator[](Index choice) const
     /// @returns subpattern string or "" when not set.
@@ -265,17 +502,29 @@ class Pattern {
   {
     return choice >= 1 && choice <= size() && acc_.at(choice - 1);
   }
+  /// Check if the DFA is constructed on demand by the matcher, with option y or when the subset construction exceeded the states of option v.
+  bool on_demand() const
+    /// @returns true if the DFA is constructed on demand.
+  {
+    return lzy_ != NULL;
+  }
   /// Get the number of finite state machine nodes (vertices).
   size_t nodes() const
-    /// @returns number of nodes or 0 when no finite state machine was constructed by this pattern.
+    /// @returns number of nodes, the nodes constructed so far when the budget was exceeded, or 0 when no finite state machine was constructed by this pattern.
   {
-    return nop_ ? vno_ : 0;
+    return vno_;
+  }
+  /// Get the number of finite state machine nodes (vertices) constructed before DFA minimization with option `d`.
+  size_t nodes_unminimized() const
+    /// @returns number of nodes before minimization, equal to nodes() when the DFA was not minimized.
+  {
+    return nop_ ? uno_ : vno_;
   }
   /// Get the number of finite state machine edges (transitions on input characters).
   size_t edges() const
-    /// @returns number of edges or 0 when no finite state machine was constructed by this pattern.
+    /// @returns number of edges, the edges constructed so far when the budget was exceeded, or 0 when no finite state machine was constructed by this pattern.
   {
-    return nop_ ? eno_ : 0;
+    return eno_;
   }
   /// Get the code size in number of words.
   size_t words() const
@@ -283,6 +532,30 @@ class Pattern {
   {
     return nop_;
   }
+  /// Get a string that all matches contain, which is useful to search the input for potential matches.
+  const std::string& needle() const
+    /// @returns the string or "" when no string is contained in all matches.
+  {
+    return ndl_;
+  }
+  /// Get the min number of chars that precede the needle() in a match.
+  size_t needle_min() const
+    /// @returns min number of chars.
+  {
+    return nmn_;
+  }
+  /// Get the max number of chars that precede the needle() in a match.
+  size_t needle_max() const
+    /// @returns max number of chars or std::string::npos when unbounded.
+  {
+    return nmx_;
+  }
+  /// Check if a match contains no newlines before the needle(), so a match begins after the last newline before the needle.
+  bool needle_in_line() const
+    /// @returns true if no newlines precede the needle in a match.
+  {
+    return nnl_;
+  }
   /// Get elapsed regex parsing and analysis time.
   float parse_time() const
   {
@@ -310,6 +583,164 @@ class Pattern {
       size_t           pos = 0) ///< optional location of the error in regex string Pattern::rex_
     const;
  private:
+  /// Mutual exclusion lock of the threads that share the DFA states constructed on demand by the matchers of a pattern, or the states of a subset construction with option t.
+  class Mutex {
+   public:
+    /// Locks the mutex, if any, until the scope ends.
+    class Scope {
+     public:
+      Scope(Mutex *mutex)
+        :
+          mutex_(mutex)
+      {
+        if (mutex_)
+          mutex_->lock();
+      }
+      ~Scope()
+      {
+        if (mutex_)
+          mutex_->unlock();
+      }
+     private:
+      Scope(const Scope&);
+      Scope& operator=(const Scope&);
+      Mutex *mutex_;
+    };
+    Mutex();
+    ~Mutex();
+    void lock();
+    void unlock();
+   private:
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+    void *mtx_; ///< the platform's mutex
+  };
+  /// Memory pool of the containers and states used to compile a pattern, released in one shot when the arena is deleted.
+  class Arena {
+   public:
+    /// Sets the current arena of this thread and restores the previous arena when the scope ends.
+    class Scope {
+     public:
+      Scope(Arena *arena)
+        :
+          prev_(current())
+      {
+        current(arena);
+      }
+      ~Scope()
+      {
+        current(prev_);
+      }
+     private:
+      Arena *prev_;
+    };
+    Arena()
+      :
+        blk_(NULL),
+        big_(NULL),
+        ptr_(NULL),
+        end_(NULL),
+        use_(0)
+    {
+      std::memset(fre_, 0, sizeof(fre_));
+    }
+    ~Arena();
+    void *alloc(size_t size);
+    void free(
+        void  *ptr,
+        size_t size);
+    static Arena *current();
+    static void current(Arena *arena);
+    /// Get the number of bytes allocated on the heap by this arena.
+    size_t used() const
+    {
+      return use_;
+    }
+   private:
+    static const size_t ALIGN = 16;    ///< alignment and size class granularity
+    static const size_t SMAX  = 512;   ///< max size pooled, larger sizes are allocated on the heap and listed
+    static const size_t BLOCK = 65536; ///< size of the blocks allocated on the heap
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+    char *blk_;              ///< list of blocks, linked by their first word
+    void **big_;             ///< doubly-linked list of the larger sizes allocated, linked by their first two words
+    char *ptr_;              ///< free space in the last block
+    char *end_;              ///< end of the last block
+    void *fre_[SMAX / ALIGN]; ///< lists of freed memory by size class
+    size_t use_;             ///< number of bytes allocated on the heap
+  };
+  /// Allocator of the containers used to compile a pattern, allocates from the current arena of the thread when constructed, or from the heap.
+  template<typename T> class Allocator {
+   public:
+    typedef T              value_type;
+    typedef T             *pointer;
+    typedef const T       *const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef size_t         size_type;
+    typedef std::ptrdiff_t difference_type;
+    template<typename U> struct rebind { typedef Allocator<U> other; };
+    Allocator()
+      :
+        arena(Arena::current())
+    { }
+    template<typename U> Allocator(const Allocator<U>& allocator)
+      :
+        arena(allocator.arena)
+    { }
+    pointer address(reference x) const
+    {
+      return &x;
+    }
+    const_pointer address(const_reference x) const
+    {
+      return &x;
+    }
+    pointer allocate(
+        size_type   n,
+        const void *hint = NULL)
+    {
+      (void)hint;
+      return static_cast<pointer>(arena != NULL ? arena->alloc(n * sizeof(T)) : ::operator new(n * sizeof(T)));
+    }
+    void deallocate(
+        pointer   ptr,
+        size_type n)
+    {
+      if (arena != NULL)
+        arena->free(ptr, n * sizeof(T));
+      else
+        ::operator delete(ptr);
+    }
+    size_type max_size() const
+    {
+      return static_cast<size_type>(-1) / sizeof(T);
+    }
+    void construct(
+        pointer  ptr,
+        const T& x)
+    {
+      new (static_cast<void*>(ptr)) T(x);
+    }
+    void destroy(pointer ptr)
+    {
+      ptr->~T();
+    }
+    /// A copy of a container allocates from the current arena, not from the arena of the container copied.
+    Allocator select_on_container_copy_construction() const
+    {
+      return Allocator();
+    }
+    template<typename U> bool operator==(const Allocator<U>& allocator) const
+    {
+      return arena == allocator.arena;
+    }
+    template<typename U> bool operator!=(const Allocator<U>& allocator) const
+    {
+      return arena != allocator.arena;
+    }
+    Arena *arena; ///< arena to allocate from, or NULL to allocate from the heap
+  };
   typedef unsigned int            Char;
 #if defined(WITH_BITS)
   typedef Bits                    Chars; ///< represent 8-bit char (+ meta char) set as a bitvector
@@ -318,8 +749,8 @@ class Pattern {
 #endif
   typedef size_t                  Location;
   typedef ORanges<Location>       Locations;
-  typedef std::set<Location>      Set;
-  typedef std::map<int,Locations> Map;
+  typedef std::set<Location,std::less<Location>,Allocator<Location> > Set;
+  typedef std::map<int,Locations,std::less<int>,Allocator<std::pair<const int,Locations> > > Map;
   /// Finite state machine construction position information.
   struct Position {
     typedef uint64_t        value_type;
@@ -350,38 +781,141 @@ class Pattern {
     Location lazy()                  const { return static_cast<Location>(k >> 48 & 0xFFFF); }
     value_type k;
   };
-  typedef std::set<Position>           Positions;
-  typedef std::map<Position,Positions> Follow;
-  typedef std::pair<Chars,Positions>   Move;
-  typedef std::list<Move>              Moves;
+  /// Set of positions stored as a sorted vector, unions of position sets are merges without node allocations.
+  struct Positions : std::vector<Position,Allocator<Position> > {
+    typedef std::vector<Position,Allocator<Position> > container_type;
+    typedef std::less<Position>                        key_compare;
+    Positions()
+    { }
+    /// A copy allocates from the current arena, like the other containers copied.
+    Positions(const Positions& pos)
+      :
+        container_type(pos.begin(), pos.end())
+    { }
+    key_compare key_comp() const
+    {
+      return key_compare();
+    }
+    /// Insert position p, appending is O(1) when positions are inserted in order.
+    void insert(const Position& p)
+    {
+      if (empty() || back() < p)
+      {
+        push_back(p);
+      }
+      else
+      {
+        iterator i = std::lower_bound(begin(), end(), p);
+        if (*i != p)
+          container_type::insert(i, p);
+      }
+    }
+    /// Insert the sorted range of positions [first,last) by merging.
+    template<typename I> void insert(
+        I first,
+        I last)
+    {
+      size_t n = size();
+      container_type::insert(end(), first, last);
+      if (n > 0 && n < size() && !((*this)[n - 1] < (*this)[n]))
+      {
+        std::inplace_merge(begin(), begin() + n, end());
+        erase(std::unique(begin(), end()), end());
+      }
+    }
+    const_iterator find(const Position& p) const
+    {
+      const_iterator i = std::lower_bound(begin(), end(), p);
+      return i != end() && *i == p ? i : end();
+    }
+  };
+  typedef std::map<Position,Positions,std::less<Position>,Allocator<std::pair<const Position,Positions> > > Follow;
+  typedef std::pair<Chars,Positions>                                                                  Move;
+  typedef std::list<Move,Allocator<Move> >                                                            Moves;
+  /// Partition of the chars into classes of chars that no char set of the regex distinguishes, the moves of a state are computed by class.
+  struct Alphabet {
+    typedef std::vector<Index,Allocator<Index> >                                                        Classes;
+    typedef std::map<Position,Classes,std::less<Position>,Allocator<std::pair<const Position,Classes> > > Ids;
+    std::vector<Char,Allocator<Char> > lo;  ///< first char of each class in increasing order, the last entry bounds the last class
+    Ids                                ids; ///< classes of the chars at Position(loc), or at Position(loc).anchor(true) for anchored word boundaries
+  };
   /// Finite state machine.
   struct State : Positions {
-    typedef std::map<Char,std::pair<Char,State*> > Edges;
+    typedef std::map<Char,std::pair<Char,State*>,std::less<Char>,Allocator<std::pair<const Char,std::pair<Char,State*> > > > Edges;
     State(const Positions& p)
       :
         Positions(p),
         index(0),
+        dense(IMAX),
         accept(0),
         redo(false),
         next(NULL),
-        left(NULL),
-        right(NULL)
+        hash(0)
     { }
+    /// States are allocated in the current arena of the thread, or on the heap, prefixed with the arena that owns them.
+    static void *operator new(size_t size)
+    {
+      Arena *arena = Arena::current();
+      void *ptr = arena != NULL ? arena->alloc(size + OWNER) : ::operator new(size + OWNER);
+      *static_cast<Arena**>(ptr) = arena;
+      return static_cast<char*>(ptr) + OWNER;
+    }
+    /// States are freed into the arena that owns them, which may differ from the current arena of the thread.
+    static void operator delete(
+        void  *ptr,
+        size_t size)
+    {
+      if (ptr == NULL)
+        return;
+      void *mem = static_cast<char*>(ptr) - OWNER;
+      Arena *arena = *static_cast<Arena**>(mem);
+      if (arena != NULL)
+        arena->free(mem, size + OWNER);
+      else
+        ::operator delete(mem);
+    }
+    /// Get the arena that owns a state allocated with new.
+    static Arena *owner(const State *state)
+      /// @returns the arena or NULL when the state is allocated on the heap.
+    {
+      return *reinterpret_cast<Arena *const*>(reinterpret_cast<const char*>(state) - OWNER);
+    }
+    static const size_t OWNER = 16; ///< bytes prefixed to a state to record its arena, a multiple of the alignment of the arena
     // Positions positions;
     Edges  edges;
     Index  index;  ///< index of this state
+    Index  dense;  ///< row of this state in the dense transition table, or IMAX
     Index  accept; ///< nonzero if final state, the index of an accepted/captured subpattern
     bool   redo;   ///< true if this is an ignorable final state
     Set    heads;  ///< lookahead head set
     Set    tails;  ///< lookahead tail set
     State *next;   ///< points to sibling state allocated depth-first by subset construction
-    State *left;   ///< left pointer for O(log N) node insertion in the state graph
-    State *right;  ///< right pointer for O(log N) node insertion in the state graph
+    size_t hash;   ///< hash of the positions of this state
+  };
+  /// Hash table of the states constructed by subset construction, to find a state by its positions in O(1).
+  struct States {
+    States() : table(64, NULL), count(0) { }
+    void clear()
+    {
+      table.assign(64, NULL);
+      count = 0;
+    }
+    State *find(
+        const Positions& pos,
+        size_t           hash) const;
+    void insert(
+        State *state,
+        size_t hash);
+    std::vector<State*> table; ///< open addressing table with linear probing, at most half full, the size is a power of two
+    size_t              count; ///< number of states in the table
   };
   /// Global modifier modes, syntax flags, and compiler options.
   struct Option {
-    Option() : b(), e(), f(), i(), l(), m(), n(), o(), q(), r(), s(), w(), x(), z() { }
+    Option() : a(), b(), c(), d(), e(), f(), i(), l(), m(), n(), o(), q(), r(), s(), t(), v(), w(), x(), y(), z() { }
+    bool                     a; ///< generate constexpr DFA tables for reflex::TableMatcher for option f
     bool                     b; ///< disable escapes in bracket lists
+    std::string              c; ///< cache directory of compiled patterns, or empty
+    bool                     d; ///< minimize the DFA before encoding it
     Char                     e; ///< escape character, or '\0' for none, '\\' default
     std::vector<std::string> f; ///< output to files
     bool                     i; ///< case insensitive mode, also `(?i:X)`
@@ -392,10 +926,81 @@ class Pattern {
     bool                     q; ///< enable "X" quotation of verbatim content, also `(?q:X)`
     bool                     r; ///< raise syntax errors
     bool                     s; ///< single-line mode (dotall mode), also `(?s:X)`
+    size_t                   t; ///< number of threads of the subset construction, or 0
+    size_t                   v; ///< construct the DFA on demand instead when the subset construction exceeds v states, or 0
     bool                     w; ///< write error message to stderr
     bool                     x; ///< free-spacing mode, also `(?x:X)`
+    size_t                   y; ///< construct the DFA on demand in a cache of at most y opcode words, or 0
     std::string              z; ///< namespace (NAME1.NAME2.NAME3)
   };
+  /// DFA states constructed on demand by the matcher with option y or beyond the states of option v, the opcode table holds the states constructed so far.
+  struct Lazy {
+    Lazy(
+        size_t max,
+        Arena *arena)
+      :
+        arena(arena),
+        start(NULL),
+        back(NULL),
+        code(new Opcode[max]),
+        max(static_cast<Index>(max))
+    { }
+    ~Lazy()
+    {
+      Arena::Scope scope(arena);
+      while (start)
+      {
+        State *next = start->next;
+        delete start;
+        start = next;
+      }
+      delete[] code;
+    }
+    Arena    *arena;     ///< arena of the containers and states, constructed before and deleted after this object
+    Positions startpos;  ///< start positions of the regex
+    Follow    followpos; ///< followpos positions of the regex
+    Map       modifiers; ///< modifier locations of the regex
+    Map       lookahead; ///< lookahead locations of the regex
+    Alphabet  alphabet;  ///< partition of the chars of the regex into classes
+    States    states;    ///< hash table of the states constructed so far
+    State    *start;     ///< start state
+    State    *back;      ///< last state constructed
+    Opcode   *code;      ///< opcode table of max words, a state not yet constructed is a LAZY opcode word (a stub)
+    Index     max;       ///< max number of opcode words in the table, when full the table is flushed
+    Mutex     mutex;     ///< locked by a matcher while it interprets the opcode table, which a flush rewrites in place
+    std::map<Index,State*>             stubs; ///< stub index -> state, the state is constructed when its index differs
+    std::map<Index,std::vector<Index> > refs; ///< stub index -> GOTO opcodes to update when the state is constructed
+  };
+  /// DFA state of the opcode table decoded once by decode_dfa(), the matcher dispatches on its kind without interpreting opcodes.
+  struct Hop {
+    /// Kinds of decoded states.
+    enum Kind {
+      GOTO,       ///< the next state is found in the jumps of this state
+      DENSE,      ///< the next state is found in the row of this state in the dense transition table
+      TAKE_GOTO,  ///< accept, then GOTO
+      TAKE_DENSE, ///< accept, then DENSE
+      SKIP,       ///< skip the bytes that loop to this state, then find the next state in the jumps of this state
+      TAKE_SKIP,  ///< SKIP, then accept at the end of the run, then find the next state
+      HALT,       ///< halt
+      TAKE_HALT,  ///< accept, then HALT
+      OPCODE      ///< interpret the opcodes of this state, which has lookaheads or meta edges
+    };
+    static const Index NONE = 0xFFFFFFFF; ///< the next decoded state to halt, not IMAX which numbers a decoded state of a DFA with more than IMAX states
+    Index kind; ///< the Kind of this state
+    Index take; ///< accept index of this state, or 0
+    Index pc;   ///< index of this state in the opcode table
+    Index next; ///< index of the first jump of this state, the row of this state in the dense transition table, or the index of the Skip of this state
+  };
+  /// Transition of a decoded state on chars lo to hi.
+  struct Jump {
+    uint8_t lo;  ///< lowest char of the transition
+    uint8_t hi;  ///< highest char of the transition
+    Index   hop; ///< the next decoded state, or Hop::NONE to halt
+  };
+  /// Thread of the subset construction with option t, computes the moves of a part of the frontier of states.
+  struct Worker;
+  /// Enforces the Pattern::Budget of a construction, from the start of the construction by init().
+  struct Governor;
   /// Meta characters.
   enum Meta {
     META_MIN = 0x100,
@@ -417,6 +1022,11 @@ class Pattern {
   /// Initialize the pattern at construction.
   void init(const char *options);
   void init_options(const char *options);
+  std::string cache_file(const char *options) const;
+  bool map(
+      const char *filename,
+      bool        cached);
+  void unmap();
   void parse(
       Positions& startpos,
       Follow&    followpos,
@@ -467,11 +1077,56 @@ class Pattern {
       Locations& lookahead,
       Index&     iter);
   void parse_esc(Location& loc) const;
-  void compile(
-      State&     start,
-      Follow&    followpos,
-      const Map& modifiers,
-      const Map& lookahead);
+  void check_budget(
+      size_t states,
+      size_t bytes = 0);
+  bool compile(
+      State&          start,
+      Follow&         followpos,
+      const Map&      modifiers,
+      const Map&      lookahead,
+      const Alphabet& alphabet);
+  void compile_alphabet(
+      const Follow& followpos,
+      const Map&    modifiers,
+      Alphabet&     alphabet) const;
+  bool parse_literals(std::vector<std::string>& literals);
+  void compile_literals(
+      State&                          start,
+      const std::vector<std::string>& literals);
+  void compile_literals_find(const std::vector<std::string>& literals);
+  void compile_reverse();
+  void compile_find(
+      const Positions& startpos,
+      Follow&          followpos,
+      const Map&       modifiers,
+      const Map&       lookahead,
+      const Alphabet&  alphabet);
+  State *compile_state(
+      States&          states,
+      State          *&back_state,
+      const Positions& pos) const
+  {
+    return compile_state(states, back_state, pos, hash_positions(pos));
+  }
+  State *compile_state(
+      States&          states,
+      State          *&back_state,
+      const Positions& pos,
+      size_t           hash) const;
+  State *compile_frontier(
+      State          *state,
+      States&         states,
+      State         *&back_state,
+      Follow&         followpos,
+      const Map&      modifiers,
+      const Map&      lookahead,
+      const Alphabet& alphabet);
+  static size_t hash_positions(const Positions& pos);
+  size_t compile_edges(
+      State       *state,
+      const Chars& chars,
+      State       *target_state) const;
   void lazy(
       const Positions& lazypos,
       Positions&       pos) const;
@@ -481,16 +1136,22 @@ class Pattern {
       Positions&       pos1) const;
   void greedy(Positions& pos) const;
   void trim_lazy(Positions& pos) const;
+  Follow::const_iterator lazy_followpos(
+      Follow&                followpos,
+      Follow::const_iterator i,
+      Position               k) const;
   void compile_transition(
-      State     *state,
-      Follow&    followpos,
+      State          *state,
+      Follow&         followpos,
+      const Map&      modifiers,
+      const Map&      lookahead,
+      const Alphabet& alphabet,
+      Moves&          moves,
+      Mutex          *mutex = NULL) const;
+  void compile_chars(
+      Position   k,
       const Map& modifiers,
-      const Map& lookahead,
-      Moves&     moves) const;
-  void transition(
-      Moves&           moves,
-      const Chars&     chars,
-      const Positions& follow) const;
+      Chars&     chars) const;
   Char compile_esc(
       Location loc,
       Chars&   chars) const;
@@ -503,19 +1164,63 @@ class Pattern {
       Chars& chars) const;
   void flip(Chars& chars) const;
   void assemble(State& start);
+  void minimize_dfa(State& start);
   void compact_dfa(State& start);
-  void encode_dfa(State& start);
+  void compact_edges(State *state) const;
+  void select_dense(State& start);
+  void encode_dense(const State& start);
+  Opcode *encode_dfa(
+      State& start,
+      Index& nop);
+  size_t encode_size(State *state) const;
+  Index encode_state(
+      const State *state,
+      Opcode      *opcode,
+      Index        pc) const;
+  void lazy_init(size_t max);
+  bool lazy_state(State *state) const;
+  void lazy_flush() const;
+  Index lazy_goto(Index index) const;
   void gencode_dfa(const State& start) const;
+  void gentable_dfa(const State& start) const;
   void gencode_dfa_closure(
       FILE *fd,
       const State *start,
       int nest) const;
   void delete_dfa(State& start);
+  void predict_match_dfa();
+  void predict_needle_dfa();
+  void decode_dfa();
+  static bool check_opcodes(
+      const Opcode *code,
+      uint64_t      size,
+      uint64_t      rows);
+  static bool skip_loop(
+      const bool *loop,
+      Skip&       skip);
+  static bool skip_dfa(
+      const State& state,
+      Skip&        skip);
   void export_dfa(const State& start) const;
   void export_code() const;
   void write_namespace_open(FILE* fd) const;
   void write_namespace_close(FILE* fd) const;
 
+  /// Returns the decoded state at index pc of the opcode table, or NULL.
+  const Hop *hop_at(Index pc) const
+  {
+    size_t lo = 0;
+    size_t hi = hop_.size();
+    while (lo < hi)
+    {
+      size_t mid = (lo + hi) / 2;
+      if (hop_[mid].pc < pc)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo < hop_.size() && hop_[lo].pc == pc ? &hop_[lo] : NULL;
+  }
   Location find_at(
       Location loc,
       char     c) const
@@ -604,6 +1309,18 @@ class Pattern {
     if (!is_meta(lo)) return lo << 24 | hi << 16 | index;
     return 0xFF000000 | (lo - META_MIN) << 16 | index;
   }
+  static Opcode opcode_long(Index index)
+  {
+    return 0xFF800000 + index;
+  }
+  static Opcode opcode_lazy()
+  {
+    return 0xFF7D0000;
+  }
+  static Opcode opcode_dense(Index row)
+  {
+    return 0xFF7C0000 | row;
+  }
   static Opcode opcode_halt()
   {
     return 0x00FF0000 | IMAX;
@@ -628,6 +1345,14 @@ class Pattern {
   {
     return opcode == (0x00FF0000 | IMAX);
   }
+  static bool is_opcode_dense(Opcode opcode)
+  {
+    return (opcode & 0xFFFF0000) == 0xFF7C0000;
+  }
+  static bool is_opcode_long(Opcode opcode)
+  {
+    return (opcode & 0xFFFF) == LONG;
+  }
   static bool is_opcode_meta(Opcode opcode)
   {
     return (opcode & 0xFF800000) == 0xFF000000;
@@ -658,6 +1383,14 @@ class Pattern {
   {
     return opcode & 0xFFFF;
   }
+  static Index index_of(const Opcode *pc)
+  {
+    return is_opcode_long(*pc) ? long_index_of(pc[1]) : index_of(*pc);
+  }
+  static Index long_index_of(Opcode opcode)
+  {
+    return opcode - 0xFF800000;
+  }
   static Char lowercase(Char c)
   {
     return static_cast<unsigned char>(c | 0x20);
@@ -674,15 +1407,40 @@ class Pattern {
   std::string           rex_; ///< regular expression string
   std::vector<Location> end_; ///< entries point to the subpattern's ending '|' or '\0'
   std::vector<bool>     acc_; ///< true if subpattern n is accepting (state is reachable)
-  size_t                vno_; ///< number of finite state machine vertices |V|
-  size_t                eno_; ///< number of finite state machine edges |E|
+  mutable size_t        vno_; ///< number of finite state machine vertices |V|, updated by the matchers of a lazy DFA
+  size_t                uno_; ///< number of finite state machine vertices |V| before minimization
+  mutable size_t        eno_; ///< number of finite state machine edges |E|, updated by the matchers of a lazy DFA
   const Opcode         *opc_; ///< points to the opcode table
-  Index                 nop_; ///< number of opcodes generated
+  mutable Index         nop_; ///< number of opcodes generated, updated by the matchers of a lazy DFA
   FSM                   fsm_; ///< function pointer to FSM code
+  Lazy                 *lzy_; ///< DFA states constructed on demand with option y or beyond the states of option v, or NULL
+  Budget               *bgt_; ///< resource budget of the construction, or NULL
+  Governor             *gov_; ///< enforces the budget while the pattern is constructed, or NULL
   float                 pms_; ///< ms elapsed time to parse regex
   float                 vms_; ///< ms elapsed time to compile DFA vertices
   float                 ems_; ///< ms elapsed time to compile DFA edges
   float                 wms_; ///< ms elapsed time to assemble code words
+  const Opcode         *fop_; ///< points to the opcode table of the unanchored search DFA or NULL
+  Index                 nfo_; ///< number of opcodes of the unanchored search DFA
+  const Opcode         *rop_; ///< points to the opcode table of the reverse DFA to find the begin of a match found by the unanchored search DFA, or NULL
+  Index                 nro_; ///< number of opcodes of the reverse DFA
+  const Index          *dns_; ///< dense transition table of nds_ rows by ncl_ byte classes with state indices (IMAX for none) or NULL
+  Index                 nds_; ///< number of rows of the dense transition table
+  Index                 ncl_; ///< number of byte classes
+  uint8_t               cls_[256]; ///< cls_[c] is the byte class of char c, chars in a class have the same transitions in dense states
+  std::vector<Hop>      hop_; ///< the states of the opcode table decoded for the matcher, sorted by their index in the opcode table, or empty
+  std::vector<Jump>     jmp_; ///< the jumps of the decoded states on chars
+  std::vector<Index>    hds_; ///< dense transition table of nds_ rows by ncl_ byte classes with decoded states (Hop::NONE to halt), or empty
+  std::vector<Skip>     skp_; ///< the exit bytes of the decoded SKIP states
+  const char           *mem_; ///< memory-mapped file of a loaded pattern with the opcode tables and dense transition table, or NULL
+  size_t                nme_; ///< size of the memory-mapped file
+  std::string           pre_; ///< prefix string of chars that all matches begin with, or empty
+  bool                  fst_[256]; ///< fst_[c] is true if char c may begin a match
+  size_t                fno_; ///< number of chars in fst_ that may begin a match, zero when unknown
+  std::string           ndl_; ///< needle string that all matches contain, or empty
+  size_t                nmn_; ///< min number of chars that precede the needle in a match
+  size_t                nmx_; ///< max number of chars that precede the needle in a match, or npos when unbounded
+  bool                  nnl_; ///< true if no newlines precede the needle in a match
 };
 
 } // namespace reflex
@@ -38,22 +38,25 @@
 #define REFLEX_POSIX_H
 
 #include <cstring>
-#include <map>
 
 namespace reflex {
 
 namespace Posix {
 
-class Tables {
- public:
-  struct lt {
-    bool operator()(const char *a, const char *b) const { return std::strcmp(a, b) < 0; }
-  };
-  typedef std::map<const char*,const int*,lt> Range;
-  Tables();
-  Range range;
+/// Name of a character class and its ranges, tables of names are sorted by name to find a name by binary search without constructing the tables at startup.
+struct Table {
+  const char *name;  ///< name of the character class
+  const int  *range; ///< pairs of bounds [lo,hi] of the ranges, ending with 0, 0
 };
 
+/// Find the ranges of a name in a table sorted by name.
+const int * range(
+    const Table *table, ///< table sorted by name
+    size_t       size,  ///< number of names in the table
+    const char  *name)  ///< name to find
+  /// @returns ranges or NULL when not found.
+  ;
+
 const int * range(const char *);
 
 }
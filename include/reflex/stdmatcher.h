@@ -180,6 +180,7 @@ class StdMatcher : public PatternMatcher<std::regex> {
         if (grow()) // make sure we have enough storage to read input
           itr_ = fin_; // buffer shifting/growing invalidates iterator
         end_ += get(buf_ + end_, blk_ ? blk_ : max_ - end_); // get() may also wrap()
+        buf_[end_] = '\0';
         DBGLOGN("Got more input pos = %zu end = %zu max = %zu", pos_, end_, max_);
       }
       if (pos_ == end_) // if pos_ is hitting the end_ then
@@ -0,0 +1,235 @@
+/******************************************************************************\
+* Copyright (c) 2026, Robert van Engelen, Genivia Inc. All rights reserved.    *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+*   (1) Redistributions of source code must retain the above copyright notice, *
+*       this list of conditions and the following disclaimer.                  *
+*                                                                              *
+*   (2) Redistributions in binary form must reproduce the above copyright      *
+*       notice, this list of conditions and the following disclaimer in the    *
+*       documentation and/or other materials provided with the distribution.   *
+*                                                                              *
+*   (3) The name of the author may not be used to endorse or promote products  *
+*       derived from this software without specific prior written permission.  *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED *
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO   *
+* EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,       *
+* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, *
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;  *
+* OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,     *
+* WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR      *
+* OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF       *
+* ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                                   *
+\******************************************************************************/
+
+/**
+@file      tablematcher.h
+@brief     RE/flex matcher engine specialized on constexpr DFA tables
+@author    Robert van Engelen - engelen@genivia.com
+@copyright (c) 2026, Robert van Engelen, Genivia Inc. All rights reserved.
+@copyright (c) BSD-3 License - see LICENSE.txt
+*/
+
+#ifndef REFLEX_TABLEMATCHER_H
+#define REFLEX_TABLEMATCHER_H
+
+#include <reflex/absmatcher.h>
+
+#if __cplusplus < 201103L && !(defined(_MSC_VER) && _MSC_VER >= 1900)
+#error "reflex/tablematcher.h requires C++11 or greater"
+#endif
+
+namespace reflex {
+
+/// RE/flex matcher engine class specialized on a table type T generated with reflex::Pattern option "a" (with option "f"), implements reflex::AbstractMatcher pattern matching interface with scan, find, split functors and iterators.
+/**
+The table type T is a struct with `constexpr` static members `start` and `halt`
+states, a byte class table `cls[256]`, a transition table `next[states][classes]`,
+the accept index of each state `take[states]` and the bytes that may begin a
+match `first[256]`.  Because these are compile-time constants, the transitions
+are specialized and inlined into the matcher without indirection through a
+reflex::Pattern object.
+
+The DFA tables do not support anchors, word boundaries, lookaheads and
+indentation matching.  All input is buffered before matching, which is
+efficient for files and strings, but not for interactive input: the block size
+set with AbstractMatcher::buffer(size_t) or AbstractMatcher::interactive() is
+ignored and the rest of the input is buffered by the next match.
+*/
+template<typename T> /// @tparam <T> the DFA table struct generated with reflex::Pattern option "a"
+class TableMatcher : public AbstractMatcher {
+ public:
+  /// The pattern type of this matcher is the DFA table type T, which has static members only.
+  typedef T Pattern;
+  /// Construct matcher engine from an input character sequence.
+  TableMatcher(
+      const Input& input = Input(), ///< input character sequence for this matcher
+      const char  *opt = NULL)      ///< option string of the form `(A|N|T(=[[:digit:]])?|;)*`
+    :
+      AbstractMatcher(input, opt)
+  {
+    reset();
+  }
+  /// Construct matcher engine from the DFA tables and an input character sequence, as used by reflex::AbstractLexer.
+  TableMatcher(
+      const Pattern&,             ///< the DFA tables
+      const Input&   input,       ///< input character sequence for this matcher
+      const char    *opt = NULL)  ///< option string of the form `(A|N|T(=[[:digit:]])?|;)*`
+    :
+      AbstractMatcher(input, opt)
+  {
+    reset();
+  }
+  /// Copy constructor, the underlying input is shared.
+  TableMatcher(const TableMatcher& matcher) ///< matcher to copy
+    :
+      AbstractMatcher(matcher.in, matcher.opt_)
+  {
+    reset();
+  }
+  /// Reset this matcher's state to the initial state and when assigned new input.
+  virtual void reset(const char *opt = NULL)
+  {
+    DBGLOG("TableMatcher::reset()");
+    AbstractMatcher::reset(opt);
+    buffer(); // no partial matching supported: buffer all input
+  }
+  /// Returns an object of the table type T for reflex::AbstractLexer::new_matcher, which is not meaningful other than for its type: the DFA tables are the static members of T.
+  const Pattern& pattern() const
+    /// @returns an object of type T without state.
+  {
+    static const Pattern tables = Pattern();
+    return tables;
+  }
+  /// Returns captured text as a std::pair<const char*,size_t> with string pointer (non-0-terminated) and length.
+  virtual std::pair<const char*,size_t> operator[](size_t n)
+    /// @returns std::pair of string pointer and length in the buffer, or the (0,0) pair for n > 0 (no group captures supported).
+    const
+  {
+    if (n == 0)
+      return std::pair<const char*,size_t>(txt_, len_);
+    return std::pair<const char*,size_t>(static_cast<const char*>(NULL), 0);
+  }
+  /// Returns the length of the longest match of the DFA tables at s before e, sets cap to the accept index of the match or zero.
+  static size_t longest(
+      const unsigned char *s,   ///< points to the first char to match
+      const unsigned char *e,   ///< points to the end of the input
+      size_t&              cap) ///< the accept index of the longest match, or zero
+    /// @returns the length of the longest match.
+  {
+    const unsigned char *p = s;
+    const unsigned char *m = s;
+    typename T::state_type state = T::start;
+    cap = 0;
+    while (true)
+    {
+      if (T::take[state] != 0)
+      {
+        cap = T::take[state];
+        m = p;
+      }
+      if (p == e)
+        break;
+      state = T::next[state][T::cls[*p]];
+      if (state == T::halt)
+        break;
+      ++p;
+    }
+    return m - s;
+  }
+ protected:
+  /// Returns the position of the first byte at or after loc that may begin a match, or the end of the buffered input.
+  size_t skip(
+      const unsigned char *b,   ///< points to the buffered input
+      size_t               loc) ///< position to start from
+    const
+    /// @returns position in the buffered input.
+  {
+    // check the bounds only at a \0, which may be the sentinel \0 at end_
+    while (!T::first[b[loc]] && (b[loc] != '\0' || loc < end_))
+      ++loc;
+    return loc;
+  }
+  /// The match method Const::SCAN, Const::FIND, Const::SPLIT, or Const::MATCH, implemented with the DFA tables.
+  virtual size_t match(Method method)
+    /// @returns nonzero when input matched the pattern using method Const::SCAN, Const::FIND, Const::SPLIT, or Const::MATCH.
+  {
+    DBGLOG("BEGIN TableMatcher::match(%d)", method);
+    reset_text();
+    if (blk_ > 0)
+      (void)buffer(); // no partial matching supported: buffer the rest of the input
+    const unsigned char *b = reinterpret_cast<const unsigned char*>(buf_);
+    const unsigned char *e = b + end_;
+    txt_ = buf_ + cur_;
+    len_ = 0;
+    switch (method)
+    {
+      case Const::SCAN:
+        len_ = longest(b + cur_, e, cap_);
+        if (len_ == 0)
+          cap_ = 0;
+        break;
+      case Const::FIND:
+        cap_ = 0;
+        for (size_t loc = cur_; (loc = skip(b, loc)) < end_; ++loc)
+        {
+          len_ = longest(b + loc, e, cap_);
+          if (cap_ > 0 && len_ > 0)
+          {
+            txt_ = buf_ + loc;
+            break;
+          }
+          cap_ = 0;
+        }
+        if (cap_ == 0)
+        {
+          len_ = 0;
+          set_current(end_);
+        }
+        break;
+      case Const::SPLIT:
+        if (eof_)
+        {
+          cap_ = 0;
+          break;
+        }
+        for (size_t loc = cur_; (loc = skip(b, loc)) < end_; ++loc)
+        {
+          size_t n = longest(b + loc, e, cap_);
+          if (cap_ > 0 && n > 0)
+          {
+            len_ = loc - cur_;
+            set_current(loc + n);
+            DBGLOG("END TableMatcher::match() split: act = %zu", cap_);
+            return cap_;
+          }
+        }
+        cap_ = Const::EMPTY;
+        len_ = end_ - cur_;
+        set_current(end_);
+        eof_ = true;
+        DBGLOG("END TableMatcher::match() split: empty end");
+        return cap_;
+      default: // Const::MATCH
+        len_ = longest(b + cur_, e, cap_);
+        if (cur_ + len_ != end_)
+        {
+          len_ = 0;
+          cap_ = 0;
+        }
+        break;
+    }
+    if (cap_ > 0)
+      set_current(txt_ - buf_ + len_);
+    DBGLOG("END TableMatcher::match() act = %zu len = %zu", cap_, len_);
+    return cap_;
+  }
+};
+
+} // namespace reflex
+
+#endif
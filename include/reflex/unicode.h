@@ -43,14 +43,12 @@ namespace reflex {
 
 namespace Unicode {
 
-class Tables : public Posix::Tables {
- public:
-  Tables();
- private:
-  void block_scripts(void);
-  void language_scripts(void);
-  void letter_scripts(void);
-};
+extern const Posix::Table block_scripts[];         ///< Unicode blocks sorted by name, generated by unicode/block_scripts.l
+extern const size_t       block_scripts_size;      ///< number of Unicode blocks
+extern const Posix::Table language_scripts[];      ///< Unicode scripts and properties sorted by name, generated by unicode/language_scripts.l
+extern const size_t       language_scripts_size;   ///< number of Unicode scripts and properties
+extern const Posix::Table letter_scripts[];        ///< Unicode letter categories sorted by name, generated by unicode/letter_scripts.l
+extern const size_t       letter_scripts_size;     ///< number of Unicode letter categories
 
 const int * range(const char *);
 
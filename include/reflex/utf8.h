@@ -37,6 +37,7 @@
 #ifndef REFLEX_UTF8_H
 #define REFLEX_UTF8_H
 
+#include <reflex/ranges.h>
 #include <cstring>
 #include <string>
 
@@ -71,6 +72,14 @@ std::string utf8(
   /// @returns regex string to match the UCS range encoded in UTF-8.
   ;
 
+/// Convert a set of UCS-4 ranges to a strict UTF-8 regex pattern with the byte ranges of the sequences that continue alike merged into one bracket list.
+std::string utf8(
+    const ORanges<int>& ranges,     ///< set of UCS ranges
+    int                 esc = 'x',  ///< escape char 'x' for hex \xXX, or '0' or '\0' for octal \0nnn and \nnn
+    const char         *par = "(")  ///< capturing or non-capturing parenthesis "(?:"
+  /// @returns regex string to match the set of UCS ranges encoded in UTF-8.
+  ;
+
 /// Convert UCS-4 to UTF-8, fills with REFLEX_NONCHAR_UTF8 when out of range, or unrestricted UTF-8 with WITH_UTF8_UNRESTRICTED.
 inline size_t utf8(
     int   c, ///< UCS-4 character U+0000 to U+10ffff (unless WITH_UTF8_UNRESTRICTED)
@@ -98,74 +98,38 @@ static std::string posix_class(const char *s, int esc)
   return regex;
 }
 
-static std::string unicode_class(const char *s, int esc, const char *par)
+/// Regex translations of the sets of Unicode ranges converted, to translate a class used repeatedly in a regex only once.
+typedef std::map<ORanges<int>,std::string> Translations;
+
+static const std::string& unicode_ranges(const ORanges<int>& ranges, int esc, const char *par, Translations& translations)
+{
+  Translations::iterator i = translations.find(ranges);
+  if (i == translations.end())
+  {
+    std::string regex = utf8(ranges, esc, par);
+    if (regex.find('|') != std::string::npos)
+      regex.insert(0, par).push_back(')');
+    i = translations.insert(Translations::value_type(ranges, regex)).first;
+  }
+  return i->second;
+}
+
+static std::string unicode_class(const char *s, int esc, const char *par, Translations& translations)
 {
-  std::string regex;
   const int *wc = Unicode::range(s + (s[0] == '^'));
-  if (wc != NULL)
+  if (wc == NULL)
+    return "";
+  ORanges<int> ranges(wc[0], wc[1]);
+  for (wc += 2; wc[1] != 0; wc += 2)
+    ranges.insert(wc[0], wc[1]);
+  if (s[0] == '^')
   {
-    if (s[0] == '^')
-    {
-      if (wc[0] > 0x00)
-      {
-        if (wc[0] > 0xDFFF)
-        {
-          // exclude U+D800 to U+DFFF
-          regex.assign(utf8(0x00, 0xD7FF, esc, par)).push_back('|');
-          if (wc[0] > 0xE000)
-            regex.append(utf8(0xE000, wc[0] - 1, esc, par)).push_back('|');
-        }
-        else
-        {
-          regex.assign(utf8(0x00, wc[0] - 1, esc, par)).push_back('|');
-        }
-      }
-      int last = wc[1] + 1;
-      wc += 2;
-      for (; wc[1] != 0; wc += 2)
-      {
-        if (last <= 0xD800 && wc[0] > 0xDFFF)
-        {
-          // exclude U+D800 to U+DFFF
-          if (last < 0xD800)
-            regex.append(utf8(last, 0xD7FF, esc, par)).push_back('|');
-          if (wc[0] > 0xE000)
-            regex.append(utf8(0xE000, wc[0] - 1, esc, par)).push_back('|');
-        }
-        else
-        {
-          regex.append(utf8(last, wc[0] - 1, esc, par)).push_back('|');
-        }
-        last = wc[1] + 1;
-      }
-      if (last <= 0x10FFFF)
-      {
-        if (last <= 0xD800)
-        {
-          // exclude U+D800 to U+DFFF
-          if (last < 0xD800)
-            regex.append(utf8(last, 0xD7FF, esc, par)).push_back('|');
-          regex.append(utf8(0xE000, 0x10FFFF, esc, par)).push_back('|');
-        }
-        else
-        {
-          regex.append(utf8(last, 0x10FFFF, esc, par)).push_back('|');
-        }
-      }
-      if (!regex.empty())
-        regex.resize(regex.size() - 1);
-    }
-    else
-    {
-      regex.assign(utf8(wc[0], wc[1], esc, par));
-     wc += 2;
-      for (; wc[1] != 0; wc += 2)
-        regex.append("|").append(utf8(wc[0], wc[1], esc, par));
-    }
+    ORanges<int> inverse(0x00, 0x10FFFF);
+    inverse -= ORanges<int>(0xD800, 0xDFFF); // exclude U+D800 to U+DFFF
+    inverse -= ranges;
+    ranges.swap(inverse);
   }
-  if (regex.find('|') != std::string::npos)
-    regex.insert(0, par).push_back(')');
-  return regex;
+  return unicode_ranges(ranges, esc, par, translations);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -235,7 +199,7 @@ inline int hex_or_octal_escape(const char *signature)
 //                                                                            //
 ////////////////////////////////////////////////////////////////////////////////
 
-static void convert_escape_char(const char *pattern, size_t& loc, size_t& pos, const char *signature, const std::map<size_t,std::string>& mod, const char *par, std::string& regex)
+static void convert_escape_char(const char *pattern, size_t& loc, size_t& pos, const char *signature, const std::map<size_t,std::string>& mod, const char *par, Translations& translations, std::string& regex)
 {
   int c = pattern[pos];
   if (std::strchr(regex_unescapes, c) != NULL)
@@ -258,7 +222,7 @@ static void convert_escape_char(const char *pattern, size_t& loc, size_t& pos, c
     std::string translated;
     int esc = hex_or_octal_escape(signature);
     if (is_modified(mod, 'u'))
-      translated = unicode_class(name, esc, par);
+      translated = unicode_class(name, esc, par, translations);
     else if (!supports_escape(signature, c))
       translated = posix_class(name, esc);
     if (!translated.empty())
@@ -390,7 +354,7 @@ static int convert_hex(const char *pattern, size_t len, size_t& pos, convert_fla
   return -1;
 }
 
-static void convert_escape(const char *pattern, size_t len, size_t& loc, size_t& pos, convert_flag_type flags, const char *signature, const std::map<size_t,std::string>& mod, const char *par, std::string& regex)
+static void convert_escape(const char *pattern, size_t len, size_t& loc, size_t& pos, convert_flag_type flags, const char *signature, const std::map<size_t,std::string>& mod, const char *par, Translations& translations, std::string& regex)
 {
   int c = pattern[pos];
   if (c == '\n' || c == '\r')
@@ -513,7 +477,7 @@ static void convert_escape(const char *pattern, size_t len, size_t& loc, size_t&
     }
     else
     {
-      convert_escape_char(pattern, loc, pos, signature, mod, par, regex);
+      convert_escape_char(pattern, loc, pos, signature, mod, par, translations, regex);
     }
   }
   else if (c == 'p' || c == 'P')
@@ -543,7 +507,7 @@ static void convert_escape(const char *pattern, size_t len, size_t& loc, size_t&
     int esc = hex_or_octal_escape(signature);
     if (is_modified(mod, 'u'))
     {
-      translated = unicode_class(name.c_str(), esc, par);
+      translated = unicode_class(name.c_str(), esc, par, translations);
       if (translated.empty())
         throw regex_error(regex_error::invalid_class, pattern, pos);
     }
@@ -564,7 +528,7 @@ static void convert_escape(const char *pattern, size_t len, size_t& loc, size_t&
   }
   else
   {
-    convert_escape_char(pattern, loc, pos, signature, mod, par, regex);
+    convert_escape_char(pattern, loc, pos, signature, mod, par, translations, regex);
   }
 }
 
@@ -1155,16 +1119,9 @@ static void insert_list(const char *pattern, size_t len, size_t& pos, convert_fl
     throw regex_error(regex_error::empty_class, pattern, loc);
 }
 
-static std::string convert_unicode_ranges(const ORanges<int>& ranges, const char *signature, const char *par)
+static const std::string& convert_unicode_ranges(const ORanges<int>& ranges, const char *signature, const char *par, Translations& translations)
 {
-  std::string regex;
-  int esc = hex_or_octal_escape(signature);
-  for (ORanges<int>::const_iterator i = ranges.begin(); i != ranges.end(); ++i)
-    regex.append(utf8(i->first, i->second - 1, esc, par)).push_back('|');
-  regex.resize(regex.size() - 1);
-  if (regex.find('|') != std::string::npos)
-    regex.insert(0, par).push_back(')');
-  return regex;
+  return unicode_ranges(ranges, hex_or_octal_escape(signature), par, translations);
 }
 
 static std::string convert_posix_ranges(const ORanges<int>& ranges, const char *signature)
@@ -1206,6 +1163,7 @@ std::string convert(const char *pattern, const char *signature, convert_flag_typ
   bool can = std::strchr(signature, ':') != NULL;
   const char *par = can ? "(?:" : "(";
   std::map<size_t,std::string> mod;
+  Translations translations;
   if ((flags & convert_flag::anycase))
     enable_modifier('i', pattern, 0, mod, 0);
   if ((flags & convert_flag::multiline))
@@ -1345,7 +1303,7 @@ std::string convert(const char *pattern, const char *signature, convert_flag_typ
         }
         else
         {
-          convert_escape(pattern, len, loc, pos, flags, signature, mod, par, regex);
+          convert_escape(pattern, len, loc, pos, flags, signature, mod, par, translations, regex);
           anc = (std::strchr(regex_anchors, c) != NULL);
           beg = false;
         }
@@ -1603,7 +1561,7 @@ std::string convert(const char *pattern, const char *signature, convert_flag_typ
               inverse -= ranges;
               if (inverse.empty())
                 throw regex_error(regex_error::empty_class, pattern, loc);
-              regex.append(convert_unicode_ranges(inverse, signature, par));
+              regex.append(convert_unicode_ranges(inverse, signature, par, translations));
             }
             else
             {
@@ -1630,7 +1588,7 @@ std::string convert(const char *pattern, const char *signature, convert_flag_typ
               if (ranges.empty())
                 throw regex_error(regex_error::empty_class, pattern, loc);
               // Unicode: translate [ ] to new regex
-              regex.append(convert_unicode_ranges(ranges, signature, par));
+              regex.append(convert_unicode_ranges(ranges, signature, par, translations));
             }
             else
             {
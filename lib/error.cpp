@@ -59,6 +59,7 @@ std::string regex_error::regex_error_message(regex_error_type code, const char *
     "invalid syntax", 
     "exceeds complexity limits", 
     "undefined name", 
+    "exceeds resource budget", 
   };
 
   const char *s = messages[code];
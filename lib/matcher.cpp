@@ -36,14 +36,65 @@
 
 #include <reflex/matcher.h>
 
+#if defined(__GNUC__) && !defined(WITH_NO_COMPUTED_GOTO)
+/// This compile-time option dispatches on the kinds of decoded DFA states with labels as values (GCC and Clang).
+#define WITH_COMPUTED_GOTO
+#endif
+
+#if defined(WITH_COMPUTED_GOTO)
+#define HOP_DISPATCH goto *hop_kind[hop->kind]
+#else
+#define HOP_DISPATCH \
+  switch (hop->kind) \
+  { \
+    case Pattern::Hop::GOTO:       goto hop_goto; \
+    case Pattern::Hop::DENSE:      goto hop_dense; \
+    case Pattern::Hop::TAKE_GOTO:  goto hop_take_goto; \
+    case Pattern::Hop::TAKE_DENSE: goto hop_take_dense; \
+    case Pattern::Hop::SKIP:       goto hop_skip; \
+    case Pattern::Hop::TAKE_SKIP:  goto hop_take_skip; \
+    case Pattern::Hop::HALT:       goto hop_halt; \
+    case Pattern::Hop::TAKE_HALT:  goto hop_take_halt; \
+    default:                       goto hop_opcode; \
+  }
+#endif
+
 namespace reflex {
 
 size_t Matcher::match(Method method)
 {
   DBGLOG("BEGIN Matcher::match()");
   reset_text();
+  size_t fnd = 0; // no match ends before this position when searching with the unanchored search DFA
+  size_t nxt = 0; // the next needle is located before this position when searching for the needle
 scan:
   mrk_ = false;
+  if (method == Const::FIND)
+  {
+    if (pat_->ndl_.size() > pat_->pre_.size() && num_ + cur_ + pat_->nmn_ >= nxt)
+    {
+      size_t loc = num_ + cur_;
+      (void)skip_needle(nxt);
+      if (num_ + pos_ != loc)
+        set_current(pos_);
+      else
+        pos_ = cur_;
+    }
+    if (pat_->fop_)
+    {
+      if (num_ + cur_ >= fnd)
+        (void)advance(fnd);
+    }
+    else if (pat_->fno_ > 0)
+    {
+      size_t loc = num_ + cur_;
+      (void)skip();
+      if (num_ + pos_ != loc)
+        set_current(pos_);
+      else
+        pos_ = cur_;
+    }
+  }
   txt_ = buf_ + cur_;
   len_ = 0;
   bool bob = at_bob();
@@ -100,7 +151,133 @@ redo:
   }
   else if (pat_->opc_)
   {
+    // matchers that share a lazy DFA take turns to interpret its opcode table, which lazy_goto() extends and flushes in place
+    Pattern::Mutex::Scope lazy_lock(pat_->lzy_ ? &pat_->lzy_->mutex : NULL);
     const Pattern::Opcode *pc = pat_->opc_;
+    // the decoded DFA states are dispatched on their kind, states with lookaheads and meta edges are interpreted below
+    const Pattern::Hop *hops = pat_->hop_.empty() ? NULL : &pat_->hop_[0];
+    const Pattern::Jump *jumps = pat_->jmp_.empty() ? NULL : &pat_->jmp_[0];
+    const Pattern::Index *dense = pat_->hds_.empty() ? NULL : &pat_->hds_[0];
+    const Pattern::Skip *skips = pat_->skp_.empty() ? NULL : &pat_->skp_[0];
+    const uint8_t *cls = pat_->cls_;
+    size_t ncl = pat_->ncl_;
+    const Pattern::Hop *hop = hops;
+    // the decoded DFA states walk the buffer with a raw pointer p, the input is refilled only when the sentinel \0 at the end e of the buffered input is read
+    const unsigned char *p = NULL;
+    const unsigned char *e = NULL;
+    if (hop != NULL)
+    {
+threaded:
+#if defined(WITH_COMPUTED_GOTO)
+      static void *const hop_kind[] = { &&hop_goto, &&hop_dense, &&hop_take_goto, &&hop_take_dense, &&hop_skip, &&hop_take_skip, &&hop_halt, &&hop_take_halt, &&hop_opcode };
+#endif
+      p = reinterpret_cast<const unsigned char*>(buf_ + pos_);
+      e = reinterpret_cast<const unsigned char*>(buf_ + end_);
+      HOP_DISPATCH;
+hop_take_goto:
+      cap_ = hop->take;
+      DBGLOG("Take: cap = %zu", cap_);
+      cur_ = p - reinterpret_cast<const unsigned char*>(buf_);
+hop_goto:
+      c1 = *p++;
+      if (c1 == '\0' && p > e)
+        goto hop_sentinel;
+hop_goto_next:
+      while (true)
+      {
+        const Pattern::Jump *jump = jumps + hop->next;
+        while (c1 < jump->lo || c1 > jump->hi)
+          ++jump;
+        if (jump->hop == Pattern::Hop::NONE)
+          goto hop_halt;
+        hop = hops + jump->hop;
+        // stay in this loop without dispatching while the next state is also a GOTO state
+        if (hop->kind != Pattern::Hop::GOTO)
+          break;
+        c1 = *p++;
+        if (c1 == '\0' && p > e)
+          goto hop_sentinel;
+      }
+      HOP_DISPATCH;
+hop_take_dense:
+      cap_ = hop->take;
+      DBGLOG("Take: cap = %zu", cap_);
+      cur_ = p - reinterpret_cast<const unsigned char*>(buf_);
+hop_dense:
+      c1 = *p++;
+      if (c1 == '\0' && p > e)
+        goto hop_sentinel;
+hop_dense_next:
+      while (true)
+      {
+        Pattern::Index next = dense[hop->next * ncl + cls[c1]];
+        if (next == Pattern::Hop::NONE)
+          goto hop_halt;
+        hop = hops + next;
+        // stay in this loop without dispatching while the next state is also a DENSE state
+        if (hop->kind != Pattern::Hop::DENSE)
+          break;
+        c1 = *p++;
+        if (c1 == '\0' && p > e)
+          goto hop_sentinel;
+      }
+      HOP_DISPATCH;
+hop_take_skip:
+      cap_ = hop->take;
+      DBGLOG("Take: cap = %zu", cap_);
+hop_skip:
+      {
+        // skip the run of bytes that loop to this state up to the next exit byte
+        const Pattern::Skip *skip = skips + hop->next;
+        const unsigned char *s = p;
+        p = skip->find(p, e);
+        if (p > s)
+          c1 = p[-1];
+        if (hop->kind == Pattern::Hop::TAKE_SKIP)
+          cur_ = p - reinterpret_cast<const unsigned char*>(buf_);
+        if (p >= e)
+          goto hop_refill;
+        c1 = *p++;
+        const Pattern::Jump *jump = jumps + skip->jump;
+        while (c1 < jump->lo || c1 > jump->hi)
+          ++jump;
+        if (jump->hop == Pattern::Hop::NONE)
+          goto hop_halt;
+        hop = hops + jump->hop;
+      }
+      HOP_DISPATCH;
+hop_sentinel:
+      // the sentinel \0 was read, put it back
+      --p;
+hop_refill:
+      // p reached the end of the buffered input: read more input into the buffer, which may move the buffer
+      pos_ = p - reinterpret_cast<const unsigned char*>(buf_);
+      c1 = get();
+      DBGLOG("Get: c1 = %d", c1);
+      if (c1 == EOF)
+        goto done;
+      p = reinterpret_cast<const unsigned char*>(buf_ + pos_);
+      e = reinterpret_cast<const unsigned char*>(buf_ + end_);
+      if (hop->kind == Pattern::Hop::SKIP || hop->kind == Pattern::Hop::TAKE_SKIP)
+      {
+        // put the char back to continue skipping the run
+        --p;
+        HOP_DISPATCH;
+      }
+      if (hop->kind == Pattern::Hop::GOTO || hop->kind == Pattern::Hop::TAKE_GOTO)
+        goto hop_goto_next;
+      goto hop_dense_next;
+hop_take_halt:
+      cap_ = hop->take;
+      DBGLOG("Take: cap = %zu", cap_);
+      cur_ = p - reinterpret_cast<const unsigned char*>(buf_);
+hop_halt:
+      pos_ = p - reinterpret_cast<const unsigned char*>(buf_);
+      goto done;
+hop_opcode:
+      pos_ = p - reinterpret_cast<const unsigned char*>(buf_);
+      pc = pat_->opc_ + hop->pc;
+    }
     while (true)
     {
       Pattern::Opcode opcode = *pc;
@@ -133,10 +310,15 @@ redo:
           lap_[index] = static_cast<int>(pos_ - (txt_ - buf_)); // mind the gap
           ++pc;
           continue;
+        case 0xff7d: // LAZY
+          index = static_cast<Pattern::Index>(pc - pat_->opc_);
+          DBGLOG("Lazy: %u", index);
+          pc = pat_->opc_ + pat_->lazy_goto(index); // construct the DFA state on demand
+          continue;
         case 0xff00 | Pattern::META_DED:
           if (ded_ > 0)
           {
-            index = Pattern::index_of(opcode);
+            index = Pattern::index_of(pc);
             DBGLOG("Dedent ded = %zu", ded_); // unconditional dedent matching \j
             nul = true;
             pc = pat_->opc_ + index;
@@ -146,14 +328,14 @@ redo:
       int c0 = c1;
       if (c0 == EOF)
         break;
-      c1 = get();
+      c1 = get_sentinel();
       DBGLOG("Get: c1 = %d", c1);
       index = Pattern::IMAX;
-      Pattern::Index back = Pattern::IMAX; // where to jump back to (backtrack on meta transitions)
+      const Pattern::Opcode *back = NULL; // where to jump back to (backtrack on meta transitions)
       Pattern::Index la;
       while (true)
       {
-        if (index == Pattern::IMAX || back == Pattern::IMAX) // we no longer have to pass through all if index and back are set
+        if (index == Pattern::IMAX || back == NULL) // we no longer have to pass through all if index and back are set
         {
           switch (opcode >> 16)
           {
@@ -177,100 +359,113 @@ redo:
               continue;
             case 0xff00 | Pattern::META_DED:
               DBGLOG("DED? %d", c1);
-              if (index == Pattern::IMAX && back == Pattern::IMAX && bol && dedent(col))
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+              if (index == Pattern::IMAX && back == NULL && bol && dedent(col))
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode); // skip the long index word
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_IND:
               DBGLOG("IND? %d", c1);
-              if (index == Pattern::IMAX && back == Pattern::IMAX && bol && indent(col))
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+              if (index == Pattern::IMAX && back == NULL && bol && indent(col))
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_UND:
               DBGLOG("UND");
               if (mrk_)
-                index = Pattern::index_of(opcode);
+                index = Pattern::index_of(pc);
               mrk_ = false;
               ded_ = 0;
-              opcode = *++pc;
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_EOB:
               DBGLOG("EOB? %d", c1);
               if (index == Pattern::IMAX && c1 == EOF)
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_BOB:
               DBGLOG("BOB? %d", bob);
               if (index == Pattern::IMAX && bob)
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_EOL:
               DBGLOG("EOL? %d", c1);
               if (index == Pattern::IMAX && (c1 == EOF || c1 == '\n'))
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_BOL:
               DBGLOG("BOL? %d", bol);
               if (index == Pattern::IMAX && bol)
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_EWE:
               DBGLOG("EWE? %d %d %d", c0, c1, isword(c0) && !isword(c1));
               if (index == Pattern::IMAX && isword(c0) && !isword(c1))
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_BWE:
               DBGLOG("BWE? %d %d %d", c0, c1, !isword(c0) && isword(c1));
               if (index == Pattern::IMAX && !isword(c0) && isword(c1))
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_EWB:
               DBGLOG("EWB? %d", eow);
               if (index == Pattern::IMAX && eow)
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_BWB:
               DBGLOG("BWB? %d", bow);
               if (index == Pattern::IMAX && bow)
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_NWE:
               DBGLOG("NWE? %d %d %d", c0, c1, isword(c0) == isword(c1));
               if (index == Pattern::IMAX && isword(c0) == isword(c1))
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
             case 0xff00 | Pattern::META_NWB:
               DBGLOG("NWB? %d %d", bow, eow);
               if (index == Pattern::IMAX && !bow && !eow)
-                index = Pattern::index_of(opcode);
-              opcode = *++pc;
+                index = Pattern::index_of(pc);
+              pc += 1 + Pattern::is_opcode_long(opcode);
+              opcode = *pc;
               continue;
           }
         }
         if (index != Pattern::IMAX)
         {
           DBGLOG("Backtrack: pc = %u", index);
-          if (back == Pattern::IMAX)
-            back = static_cast<Pattern::Index>(pc - pat_->opc_);
+          if (back == NULL)
+            back = pc;
           pc = pat_->opc_ + index;
           opcode = *pc;
           index = Pattern::IMAX;
         }
         else
         {
-          if (back != Pattern::IMAX)
+          if (back != NULL)
           {
-            pc = pat_->opc_ + back;
+            pc = back;
             opcode = *pc;
           }
           break;
@@ -278,6 +473,18 @@ redo:
       }
       if (c1 == EOF)
         break;
+      if (Pattern::is_opcode_dense(opcode) && pat_->dns_ != NULL)
+      {
+        // a state with many edges on chars jumps to the next state through its row in the dense transition table
+        index = pat_->dns_[Pattern::index_of(opcode) * pat_->ncl_ + pat_->cls_[c1]];
+        DBGLOG("Dense: %u", index);
+        if (index == Pattern::IMAX)
+          break;
+        pc = pat_->opc_ + index;
+        if (hops != NULL && (hop = pat_->hop_at(index)) != NULL && hop->kind != Pattern::Hop::OPCODE)
+          goto threaded;
+        continue;
+      }
       Pattern::Opcode lo = c1 << 24;
       Pattern::Opcode hi = lo | 0x00ffffff;
 unrolled:
@@ -299,9 +506,15 @@ unrolled:
         }
       }
       index = Pattern::index_of(opcode);
-      if (index == Pattern::IMAX)
-        break;
+      if (index >= Pattern::LONG)
+      {
+        if (index == Pattern::IMAX)
+          break;
+        index = Pattern::long_index_of(pc[1]);
+      }
       pc = pat_->opc_ + index;
+      if (hops != NULL && (hop = pat_->hop_at(index)) != NULL && hop->kind != Pattern::Hop::OPCODE)
+        goto threaded;
     }
   }
 done:
@@ -422,4 +635,188 @@ done:
   return cap_;
 }
 
+bool Matcher::advance(size_t& fnd)
+{
+  DBGLOG("BEGIN Matcher::advance()");
+  size_t loc = num_ + cur_;
+  bool found = false;
+  const Pattern::Opcode *pc = pat_->fop_;
+  while (true)
+  {
+    if (pc == pat_->fop_)
+    {
+      // no match in progress: skip ahead to where a match may begin, then release the buffered input before it
+      if (pat_->fno_ > 0 && !skip())
+      {
+        cur_ = pos_;
+        break;
+      }
+      cur_ = pos_;
+      txt_ = buf_ + cur_;
+    }
+    Pattern::Opcode opcode = *pc;
+    if (Pattern::is_opcode_take(opcode))
+    {
+      fnd = num_ + pos_;
+      found = true;
+      if (pat_->rop_)
+      {
+        // run the reverse DFA back from the end of the match to the leftmost position where a match may begin
+        const Pattern::Opcode *rpc = pat_->rop_;
+        size_t beg = pos_;
+        size_t rev = pos_;
+        while (true)
+        {
+          opcode = *rpc;
+          if (Pattern::is_opcode_take(opcode))
+          {
+            beg = rev;
+            opcode = *++rpc;
+          }
+          if (rev == cur_)
+            break;
+          unsigned char c = static_cast<unsigned char>(buf_[rev - 1]);
+          while (!Pattern::is_opcode_halt(opcode) && !Pattern::is_opcode_match(opcode, c))
+            opcode = *++rpc;
+          Pattern::Index index = Pattern::index_of(rpc);
+          if (index == Pattern::IMAX)
+            break;
+          rpc = pat_->rop_ + index;
+          --rev;
+        }
+        cur_ = beg;
+      }
+      break;
+    }
+    int c = get_sentinel();
+    if (c == EOF)
+    {
+      cur_ = pos_;
+      break;
+    }
+    while (!Pattern::is_opcode_halt(opcode) && !Pattern::is_opcode_match(opcode, static_cast<unsigned char>(c)))
+      opcode = *++pc;
+    Pattern::Index index = Pattern::index_of(pc);
+    pc = pat_->fop_ + (index == Pattern::IMAX ? 0 : index);
+  }
+  DBGLOG("Advance: cur = %zu found = %d", cur_, (int)found);
+  if (num_ + cur_ != loc)
+    set_current(cur_);
+  else
+    pos_ = cur_;
+  DBGLOG("END Matcher::advance()");
+  return found;
+}
+
+bool Matcher::skip_needle(size_t& nxt)
+{
+  DBGLOG("BEGIN Matcher::skip_needle()");
+  const std::string& ndl = pat_->ndl_;
+  size_t len = ndl.size();
+  size_t min = pat_->nmn_;
+  size_t max = pat_->nmx_;
+  size_t loc = num_ + cur_ + min; // search the needle from here
+  while (true)
+  {
+    const char *s = buf_ + (loc - num_);
+    const char *e = buf_ + end_;
+    if (s + len <= e)
+    {
+      const char *t = e - len + 1;
+      while ((s = static_cast<const char*>(std::memchr(s, ndl[0], t - s))) != NULL)
+      {
+        if (std::memcmp(s, ndl.c_str(), len) == 0)
+          break;
+        ++s;
+      }
+      if (s == NULL)
+        s = t;
+    }
+    size_t low = s - buf_;
+    if (s + len <= e)
+      nxt = num_ + low + 1;
+    // a match begins at most max chars before the needle, or after the last newline before the needle
+    if (max != std::string::npos)
+    {
+      low = low > max ? low - max : 0;
+      if (low > end_)
+        low = end_;
+    }
+    else if (pat_->nnl_)
+    {
+      if (low > end_)
+        low = end_;
+      while (low > cur_ && buf_[low - 1] != '\n')
+        --low;
+    }
+    else
+    {
+      low = cur_;
+    }
+    if (low > cur_)
+      cur_ = low;
+    pos_ = cur_;
+    if (s + len <= e)
+    {
+      DBGLOG("END Matcher::skip_needle(): cur = %zu", cur_);
+      return true;
+    }
+    // release the buffered input to read more
+    loc = num_ + (s - buf_);
+    txt_ = buf_ + cur_;
+    pos_ = end_;
+    if (peek() == EOF)
+      break;
+    pos_ = cur_;
+  }
+  cur_ = pos_ = end_;
+  DBGLOG("END Matcher::skip_needle(): EOF");
+  return false;
+}
+
+bool Matcher::skip()
+{
+  DBGLOG("BEGIN Matcher::skip()");
+  const std::string& pre = pat_->pre_;
+  const bool *fst = pat_->fst_;
+  while (true)
+  {
+    const char *s = buf_ + pos_;
+    const char *e = buf_ + end_;
+    if (!pre.empty())
+    {
+      // search the prefix, which may extend beyond the buffered input
+      while ((s = static_cast<const char*>(std::memchr(s, pre[0], e - s))) != NULL)
+      {
+        size_t n = pre.size();
+        if (n > static_cast<size_t>(e - s))
+          n = e - s;
+        if (std::memcmp(s, pre.c_str(), n) == 0)
+          break;
+        ++s;
+      }
+      if (s == NULL)
+        s = e;
+    }
+    else
+    {
+      while (s < e && !fst[static_cast<unsigned char>(*s)])
+        ++s;
+    }
+    if (s < e)
+    {
+      pos_ = s - buf_;
+      DBGLOG("END Matcher::skip(): pos = %zu", pos_);
+      return true;
+    }
+    // release the buffered input to read more
+    cur_ = pos_ = end_;
+    txt_ = buf_ + cur_;
+    if (peek() == EOF)
+      break;
+  }
+  DBGLOG("END Matcher::skip(): EOF");
+  return false;
+}
+
 } // namespace reflex
@@ -36,18 +36,60 @@
 
 #include <reflex/pattern.h>
 #include <reflex/timer.h>
+#include <cstdio>
 #include <cstdlib>
 #include <cerrno>
 #include <cmath>
+#include <algorithm>
+
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(WITH_NO_SIMD)
+/// This compile-time option searches the exit bytes of a run of bytes skipped by the matcher 16 bytes at a time with SSE2.
+#define WITH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if (defined(__WIN32__) || defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(__BORLANDC__)) && !defined(__CYGWIN__) && !defined(__MINGW32__) && !defined(__MINGW64__)
+# include <process.h>
+#else
+# include <fcntl.h>
+# include <pthread.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
 
 /// DFA compaction: -1 == reverse order edge compression (best); 1 == edge compression; 0 == no edge compression.
 #define WITH_COMPACT_DFA -1
 
+/// Max number of states of the unanchored search DFA constructed for Matcher::find, which is not used when exceeded.
+#define FIND_DFA_MAX 4096
+
+/// Max number of positions added to the states of the unanchored search DFA and reverse DFA, to bound their construction time.
+#define FIND_POS_MAX 65536
+
+/// Max number of DFA states to analyze for a needle string that all matches contain.
+#define NEEDLE_DFA_MAX 1024
+
+/// Min number of edges on chars of a DFA state to use the dense transition table for the state instead of scanning its GOTO opcodes.
+#define DENSE_EDGES_MIN 8
+
+/// Max number of DFA states of the subset construction with option v without a number, beyond which the DFA is constructed on demand instead.
+#define DFA_STATES_MAX 65536
+
+/// Min number of states in the frontier of the subset construction to compute their transitions with multiple threads, when option t is set.
+#define THREAD_STATES_MIN 64
+
+/// Max number of entries of the dense transition table, which holds a row of byte classes for each state with DENSE_EDGES_MIN or more edges.
+#define DENSE_DFA_MAX 262144
+
+/// Format version of the compiled patterns saved by Pattern::save, a file with a different version is not loaded.
+#define PATTERN_FILE_VERSION 1
+
 #ifdef DEBUG
 # define DBGLOGPOS(p) \
   if ((p).accept()) \
   { \
-    DBGLOGA(" (%hu)", (p).accepts()); \
+    DBGLOGA(" (%u)", (p).accepts()); \
     if ((p).lazy()) \
       DBGLOGA("?%zu", (p).lazy()); \
     if ((p).greedy()) \
@@ -57,7 +99,7 @@
   { \
     DBGLOGA(" "); \
     if ((p).iter()) \
-      DBGLOGA("%hu.", (p).iter()); \
+      DBGLOGA("%u.", (p).iter()); \
     DBGLOGA("%lu", (p).loc()); \
     if ((p).lazy()) \
       DBGLOGA("?%zu", (p).lazy()); \
@@ -74,10 +116,34 @@ namespace reflex {
 
 #if (defined(__WIN32__) || defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(__BORLANDC__)) && !defined(__CYGWIN__) && !defined(__MINGW32__) && !defined(__MINGW64__)
 inline int fopen_s(FILE **fd, const char *name, const char *mode) { return ::fopen_s(fd, name, mode); }
+inline unsigned long process_id() { return static_cast<unsigned long>(::_getpid()); }
 #else
 inline int fopen_s(FILE **fd, const char *name, const char *mode) { return (*fd = ::fopen(name, mode)) ? 0 : errno; }
+inline unsigned long process_id() { return static_cast<unsigned long>(::getpid()); }
 #endif
 
+/// Edge [lo,hi] to a target state of the DFA decoded by Pattern::compile_reverse.
+struct ReverseEdge {
+  unsigned int lo;
+  unsigned int hi;
+  size_t       to;
+};
+
+/// Edge to a target state of the DFA decoded by Pattern::predict_needle_dfa, labelled by a single char, or -1 for multiple chars, or -2 for meta.
+struct NeedleEdge {
+  size_t to;
+  int    chr;
+  bool   nl;
+};
+
+/// Orders pointers by the values they point to.
+template<typename T> struct IndirectLess {
+  bool operator()(const T *p, const T *q) const
+  {
+    return *p < *q;
+  }
+};
+
 static void print_char(FILE *fd, int c, bool h = false)
 {
   if (c >= '\a' && c <= '\r')
@@ -154,29 +220,131 @@ void Pattern::error(regex_error_type code, size_t pos) const
     throw err;
 }
 
+/// Enforces the Pattern::Budget of a construction, the elapsed time is accumulated because the timer wraps after a minute.
+struct Pattern::Governor {
+  Governor(
+      Pattern     *pattern,
+      const Arena *arena)
+    :
+      pattern(pattern),
+      arena(arena),
+      ms(0.0)
+  {
+    timer_start(timer);
+    pattern->gov_ = pattern->bgt_ != NULL ? this : NULL;
+  }
+  ~Governor()
+  {
+    pattern->gov_ = NULL;
+  }
+  Pattern     *pattern; ///< pattern constructed
+  const Arena *arena;   ///< arena of the construction
+  timer_type   timer;   ///< timer of the construction
+  float        ms;      ///< ms elapsed time of the construction so far
+};
+
 void Pattern::init(const char *opt)
 {
   init_options(opt);
+  vno_ = 0;
+  uno_ = 0;
+  eno_ = 0;
+  // the containers and states used to compile the pattern are released in one shot with the arena
+  Arena arena;
+  Arena::Scope scope(&arena);
+  Governor governor(this, &arena);
+  std::string file;
   if (opc_)
   {
     nop_ = 0;
   }
+  else if (!opt_.c.empty() && opt_.y == 0 && opt_.f.empty() && map((file = cache_file(opt)).c_str(), true))
+  {
+    // reuse the compiled pattern saved to the cache directory
+    decode_dfa();
+    return;
+  }
   else
   {
-    Positions startpos;
-    Follow    followpos;
-    Map       modifiers;
-    Map       lookahead;
-    parse(startpos, followpos, modifiers, lookahead);
-    State start(startpos);
-    compile(start, followpos, modifiers, lookahead);
-    assemble(start);
+    check_budget(0);
+    std::vector<std::string> literals;
+    if (parse_literals(literals))
+    {
+      // an alternation of strings is compiled to a trie, without positions and subset construction
+      State start((Positions()));
+      compile_literals(start, literals);
+      assemble(start);
+      compile_literals_find(literals);
+    }
+    else if (opt_.y > 0 && opt_.f.empty())
+    {
+      lazy_init(opt_.y);
+      return;
+    }
+    else
+    {
+      Positions startpos;
+      Follow    followpos;
+      Map       modifiers;
+      Map       lookahead;
+      Alphabet  alphabet;
+      parse(startpos, followpos, modifiers, lookahead);
+      check_budget(0);
+      compile_alphabet(followpos, modifiers, alphabet);
+      State start(startpos);
+      if (!compile(start, followpos, modifiers, lookahead, alphabet))
+      {
+        // the subset construction exceeded the states of option v, construct the DFA on demand in a bounded opcode table instead
+        // the regex is parsed again into the arena of the lazy DFA, without displaying syntax errors twice
+        delete_dfa(start);
+        bool w = opt_.w;
+        opt_.w = false;
+        end_.clear();
+        lazy_init(LONG);
+        opt_.w = w;
+        return;
+      }
+      assemble(start);
+      compile_find(startpos, followpos, modifiers, lookahead, alphabet);
+    }
+  }
+  predict_match_dfa();
+  predict_needle_dfa();
+  compile_reverse();
+  decode_dfa();
+  if (!file.empty())
+  {
+    // save to a temporary file first, renaming it is atomic so other processes never load a partially saved pattern
+    char pid[24];
+    (void)::snprintf(pid, sizeof(pid), ".%lu", process_id());
+    std::string temp = file + pid;
+    if (!save(temp.c_str()) || std::rename(temp.c_str(), file.c_str()) != 0)
+      std::remove(temp.c_str());
   }
 }
 
+void Pattern::check_budget(
+    size_t states,
+    size_t bytes)
+{
+  if (gov_ == NULL)
+    return;
+  // the nodes and edges constructed so far are kept as partial statistics when the budget is exceeded
+  const Budget& budget = *bgt_;
+  gov_->ms += timer_elapsed(gov_->timer);
+  if (budget.cancelled() ||
+      (budget.states > 0 && states > budget.states) ||
+      (budget.bytes > 0 && gov_->arena->used() + bytes > budget.bytes) ||
+      (budget.ms > 0.0 && gov_->ms > budget.ms))
+    throw regex_error(regex_error::exceeds_budget, rex_.c_str());
+}
+
 void Pattern::init_options(const char *opt)
 {
+  opt_.a = false;
   opt_.b = false;
+  opt_.c.clear();
+  opt_.d = false;
   opt_.i = false;
   opt_.l = false;
   opt_.m = false;
@@ -184,8 +352,11 @@ void Pattern::init_options(const char *opt)
   opt_.q = false;
   opt_.r = false;
   opt_.s = false;
+  opt_.t = 0;
+  opt_.v = 0;
   opt_.w = false;
   opt_.x = false;
+  opt_.y = 0;
   opt_.e = '\\';
   if (opt)
   {
@@ -193,9 +364,27 @@ void Pattern::init_options(const char *opt)
     {
       switch (*s)
       {
+        case 'a':
+          opt_.a = true;
+          break;
         case 'b':
           opt_.b = true;
           break;
+        case 'c':
+          for (const char *t = s += (s[1] == '='); *s != ';' && *s != '\0'; ++t)
+          {
+            if (*t == ';' || *t == '\0')
+            {
+              if (t > s + 1)
+                opt_.c = std::string(s + 1, t - s - 1);
+              s = t;
+            }
+          }
+          --s;
+          break;
+        case 'd':
+          opt_.d = true;
+          break;
         case 'e':
           opt_.e = (*(s += (s[1] == '=') + 1) == ';' ? '\0' : *s);
           break;
@@ -220,12 +409,43 @@ void Pattern::init_options(const char *opt)
         case 's':
           opt_.s = true;
           break;
+        case 't':
+          opt_.t = 0;
+          if (s[1] == '=' && std::isdigit(static_cast<unsigned char>(s[2])))
+          {
+            char *t;
+            opt_.t = std::strtoul(s + 2, &t, 10);
+            s = t - (*t != ';');
+          }
+          break;
+        case 'v':
+          opt_.v = DFA_STATES_MAX;
+          if (s[1] == '=' && std::isdigit(static_cast<unsigned char>(s[2])))
+          {
+            char *t;
+            opt_.v = std::strtoul(s + 2, &t, 10);
+            s = t - (*t != ';');
+          }
+          break;
         case 'w':
           opt_.w = true;
           break;
         case 'x':
           opt_.x = true;
           break;
+        case 'y':
+          opt_.y = LONG;
+          if (s[1] == '=' && std::isdigit(static_cast<unsigned char>(s[2])))
+          {
+            char *t;
+            opt_.y = std::strtoul(s + 2, &t, 10);
+            s = t - (*t != ';');
+            if (opt_.y < 4096)
+              opt_.y = 4096;
+            else if (opt_.y > LONG)
+              opt_.y = LONG;
+          }
+          break;
         case 'z':
             for (const char *t = s += (s[1] == '='); *s != ';' && *s != '\0'; ++t)
             {
@@ -262,6 +482,57 @@ void Pattern::init_options(const char *opt)
   }
 }
 
+bool Pattern::parse_literals(std::vector<std::string>& literals)
+{
+  // only plain strings without case-insensitivity, quotation, free-spacing, or other escapes than '\\'
+  if (opt_.i || opt_.q || opt_.x || opt_.e != '\\')
+    return false;
+  DBGLOG("BEGIN parse_literals()");
+  timer_type t;
+  timer_start(t);
+  std::vector<Location> ends;
+  std::string literal;
+  Location loc = 0;
+  while (true)
+  {
+    Char c = at(loc);
+    if (c == '\0' || c == '|')
+    {
+      if (literal.empty())
+        break;
+      literals.push_back(literal);
+      ends.push_back(loc);
+      if (c == '\0')
+      {
+        end_.swap(ends);
+        pms_ = timer_elapsed(t);
+        DBGLOG("END parse_literals(): %zu strings", literals.size());
+        return true;
+      }
+      literal.clear();
+    }
+    else if (c == '\\')
+    {
+      c = at(++loc);
+      if (c == '\0' || std::strchr(".^$|?*+()[]{}\\/\"", c) == NULL)
+        break;
+      literal.push_back(static_cast<char>(c));
+    }
+    else if (std::strchr(".^$?*+()[]{}", c) != NULL || (c == '/' && opt_.l))
+    {
+      break;
+    }
+    else
+    {
+      literal.push_back(static_cast<char>(c));
+    }
+    ++loc;
+  }
+  literals.clear();
+  DBGLOG("END parse_literals(): not a literal pattern");
+  return false;
+}
+
 void Pattern::parse(
     Positions& startpos,
     Follow&    followpos,
@@ -277,6 +548,9 @@ void Pattern::parse(
   Index      iter;
   timer_type t;
   timer_start(t);
+  // positions store 16 bit locations in the regex
+  if (rex_.size() > IMAX)
+    error(regex_error::exceeds_limits, IMAX);
   if (at(0) == '(' && at(1) == '?')
   {
     loc = 2;
@@ -693,13 +967,24 @@ void Pattern::parse3(
       {
         if (iter * m >= IMAX)
           error(regex_error::exceeds_limits, loc);
-        // update followpos by virtually repeating sub-regex m-1 times
+        // update followpos by virtually repeating sub-regex m-1 times, followpos is ordered by iter then by loc, so skip ahead to the sub-regex locations >= b_pos of each iter instead of scanning all of followpos
         Follow followpos1;
-        for (Follow::const_iterator fp = followpos.begin(); fp != followpos.end(); ++fp)
-          if (fp->first.loc() >= b_pos)
-            for (Index i = 1; i < m; ++i)
-              for (Positions::const_iterator p = fp->second.begin(); p != fp->second.end(); ++p)
-                followpos1[fp->first.iter(iter * i)].insert(p->iter(iter * i));
+        Follow::const_iterator fp = followpos.lower_bound(Position(b_pos));
+        while (fp != followpos.end())
+        {
+          if (fp->first.loc() < b_pos)
+          {
+            fp = followpos.lower_bound(Position(b_pos).iter(fp->first.iter()));
+            continue;
+          }
+          for (Index i = 1; i < m; ++i)
+          {
+            Positions& follow = followpos1[fp->first.iter(iter * i)];
+            for (Positions::const_iterator p = fp->second.begin(); p != fp->second.end(); ++p)
+              follow.insert(p->iter(iter * i));
+          }
+          ++fp;
+        }
         for (Follow::const_iterator fp = followpos1.begin(); fp != followpos1.end(); ++fp)
           set_insert(followpos[fp->first], fp->second);
         // add m-1 times virtual concatenation (by indexed positions k.i)
@@ -1070,14 +1355,16 @@ void Pattern::parse_esc(Location& loc) const
   }
 }
 
-void Pattern::compile(
-    State&     start,
-    Follow&    followpos,
-    const Map& modifiers,
-    const Map& lookahead)
+bool Pattern::compile(
+    State&          start,
+    Follow&         followpos,
+    const Map&      modifiers,
+    const Map&      lookahead,
+    const Alphabet& alphabet)
 {
   DBGLOG("BEGIN compile()");
   State *back_state = &start;
+  States states;
   vno_ = 0;
   eno_ = 0;
   ems_ = 0.0;
@@ -1085,8 +1372,28 @@ void Pattern::compile(
   timer_start(vt);
   acc_.resize(end_.size(), false);
   trim_lazy(start);
+  states.insert(&start, hash_positions(start));
   for (State *state = &start; state; state = state->next)
   {
+    check_budget(states.count);
+    // give up when the states exceed the budget of option v, unless the DFA is saved with option f
+    if (opt_.v > 0 && states.count > opt_.v && opt_.f.empty())
+    {
+      DBGLOG("END compile() exceeds %zu states", opt_.v);
+      return false;
+    }
+    if (opt_.t > 1)
+    {
+      // the frontier of states constructed but not yet compiled is compiled by threads when the frontier is large enough
+      size_t n = 1;
+      for (State *s = state; s != back_state && n < THREAD_STATES_MIN; s = s->next)
+        ++n;
+      if (n >= THREAD_STATES_MIN)
+      {
+        state = compile_frontier(state, states, back_state, followpos, modifiers, lookahead, alphabet);
+        continue;
+      }
+    }
     Moves moves;
     timer_start(et);
     compile_transition(
@@ -1094,6 +1401,7 @@ void Pattern::compile(
         followpos,
         modifiers,
         lookahead,
+        alphabet,
         moves);
     ems_ += timer_elapsed(et);
     for (Moves::iterator i = moves.begin(); i != moves.end(); ++i)
@@ -1102,53 +1410,8 @@ void Pattern::compile(
       trim_lazy(pos);
       if (!pos.empty())
       {
-        State *target_state = &start;
-        State **branch_ptr = NULL;
-        // binary search for a matching state
-        do
-        {
-          if (pos < *target_state)
-            target_state = *(branch_ptr = &target_state->left);
-          else if (pos > *target_state)
-            target_state = *(branch_ptr = &target_state->right);
-          else
-            break;
-        } while (target_state);
-        if (!target_state)
-          back_state = back_state->next = *branch_ptr = target_state = new State(pos);
-#if defined(WITH_BITS)
-        Char lo = i->first.find_first(), j = lo, k = lo;
-        for (;;)
-        {
-          if (j != k)
-          {
-            Char hi = k - 1;
-#if WITH_COMPACT_DFA == -1
-            state->edges[lo] = std::pair<Char,State*>(hi, target_state);
-#else
-            state->edges[hi] = std::pair<Char,State*>(lo, target_state);
-#endif
-            lo = k = j;
-          }
-          if (j == Bits::npos)
-            break;
-          j = i->first.find_next(j);
-          ++k;
-          ++eno_;
-        }
-#else
-        for (Chars::const_iterator j = i->first.begin(); j != i->first.end(); ++j)
-        {
-          Char lo = j->first;
-          Char hi = j->second - 1; // -1 to adjust open ended [lo,hi)
-#if WITH_COMPACT_DFA == -1
-          state->edges[lo] = std::pair<Char,State*>(hi, target_state);
-#else
-          state->edges[hi] = std::pair<Char,State*>(lo, target_state);
-#endif
-          eno_ += hi - lo + 1;
-        }
-#endif
+        State *target_state = compile_state(states, back_state, pos);
+        eno_ += compile_edges(state, i->first, target_state);
       }
     }
     if (state->accept > 0 && state->accept <= end_.size())
@@ -1157,143 +1420,1106 @@ void Pattern::compile(
   }
   vms_ = timer_elapsed(vt) - ems_;
   DBGLOG("END compile()");
+  return true;
 }
 
-void Pattern::lazy(
-    const Positions& lazypos,
-    Positions&       pos) const
-{
-  if (!lazypos.empty())
-  {
-    Positions pos1;
-    lazy(lazypos, pos, pos1);
-    pos.swap(pos1);
-  }
-}
-
-void Pattern::lazy(
-    const Positions& lazypos,
-    const Positions& pos,
-    Positions&       pos1) const
-{
-  for (Positions::const_iterator p = pos.begin(); p != pos.end(); ++p)
-    for (Positions::const_iterator q = lazypos.begin(); q != lazypos.end(); ++q)
-      // pos1.insert(p->lazy() ? *p : p->lazy(q->loc())); // CHECKED algorithmic options: only if p is not already lazy??
-      pos1.insert(p->lazy(q->loc())); // overrides lazyness even when p is already lazy
-}
-
-void Pattern::greedy(Positions& pos) const
-{
-  Positions pos1;
-  for (Positions::const_iterator p = pos.begin(); p != pos.end(); ++p)
-    pos1.insert(p->lazy() ? *p : p->greedy(true)); // CHECKED algorithmic options: 7/29 guard added: p->lazy() ? *p : p->greedy(true)
-    // CHECKED 10/21 pos1.insert(p->lazy(0).greedy(true));
-  pos.swap(pos1);
-}
-
-void Pattern::trim_lazy(Positions& pos) const
-{
-#ifdef DEBUG
-  DBGLOG("BEGIN trim_lazy({");
-  for (Positions::const_iterator q = pos.begin(); q != pos.end(); ++q)
-    DBGLOGPOS(*q);
-  DBGLOGA(" })");
-#endif
-  Positions::reverse_iterator p = pos.rbegin();
-  while (p != pos.rend() && p->lazy())
+/// Computes the moves of every step-th state of the frontier of the subset construction.
+struct Pattern::Worker {
+  /// Arenas of the workers, one per worker, deleted after the moves allocated in them.
+  struct Arenas {
+    Arenas(size_t n)
+      :
+        arena(n, NULL)
+    {
+      for (size_t i = 0; i < n; ++i)
+        arena[i] = new Arena;
+    }
+    ~Arenas()
+    {
+      for (size_t i = 0; i < arena.size(); ++i)
+        delete arena[i];
+    }
+    /// Get the number of bytes allocated on the heap by the arenas.
+    size_t used() const
+    {
+      size_t n = 0;
+      for (size_t i = 0; i < arena.size(); ++i)
+        n += arena[i]->used();
+      return n;
+    }
+    std::vector<Arena*> arena;
+  };
+  void run()
   {
-    Location l = p->lazy();
-    if (p->accept() || p->anchor()) // CHECKED algorithmic options: 7/28 added p->anchor()
+    // the moves are allocated in the arena of this worker, because the arena of the pattern is not shared by threads
+    Arena::Scope scope(arena);
+    for (size_t i = first; i < frontier->size(); i += step)
     {
-      pos.insert(p->lazy(0)); // make lazy accept/anchor a non-lazy accept/anchor
-      pos.erase(--p.base());
-      while (p != pos.rend() && !p->accept() && p->lazy() == l)
+      Moves& m = (*moves)[i];
+      pattern->compile_transition((*frontier)[i], *followpos, *modifiers, *lookahead, *alphabet, m, mutex);
+      for (Moves::iterator j = m.begin(); j != m.end(); ++j)
       {
-#if 0 // CHECKED algorithmic options: set to 1 to turn lazy trimming off
-        ++p;
-#else
-        pos.erase(--p.base());
-#endif
+        pattern->trim_lazy(j->second);
+        (*hashes)[i].push_back(j->second.empty() ? 0 : hash_positions(j->second));
       }
     }
-    else
+  }
+#if (defined(__WIN32__) || defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(__BORLANDC__)) && !defined(__CYGWIN__) && !defined(__MINGW32__) && !defined(__MINGW64__)
+  static DWORD WINAPI start(LPVOID worker)
+  {
+    static_cast<Worker*>(worker)->run();
+    return 0;
+  }
+#else
+  static void *start(void *worker)
+  {
+    static_cast<Worker*>(worker)->run();
+    return NULL;
+  }
+#endif
+  const Pattern                     *pattern;   ///< pattern compiled
+  const std::vector<State*>         *frontier;  ///< states to compile
+  size_t                             first;     ///< first state of this worker
+  size_t                             step;      ///< number of workers
+  Follow                            *followpos; ///< followpos with the lazy followpos of the frontier memoized
+  const Map                         *modifiers; ///< modifier locations of the regex
+  const Map                         *lookahead; ///< lookahead locations of the regex
+  const Alphabet                    *alphabet;  ///< partition of the chars of the regex into classes
+  std::vector<Moves>                *moves;     ///< moves of each state
+  std::vector<std::vector<size_t> > *hashes;    ///< hash of the positions of each move of each state
+  Arena                             *arena;     ///< arena of the moves of this worker
+  Mutex                             *mutex;     ///< locks the lookahead sets of the states, which are allocated in the arena of the pattern
+};
+
+Pattern::State *Pattern::compile_frontier(
+    State          *state,
+    States&         states,
+    State         *&back_state,
+    Follow&         followpos,
+    const Map&      modifiers,
+    const Map&      lookahead,
+    const Alphabet& alphabet)
+{
+  DBGLOG("BEGIN compile_frontier()");
+  timer_type et;
+  timer_start(et);
+  std::vector<State*> frontier;
+  for (State *s = state; ; s = s->next)
+  {
+    frontier.push_back(s);
+    // memoize the lazy followpos before the threads share followpos
+    for (Positions::const_iterator k = s->begin(); k != s->end(); ++k)
     {
-#if 0 // CHECKED algorithmic options: 7/31
-      if (p->greedy())
-      {
-        pos.insert(p->lazy(0).greedy(false));
-        pos.erase(--p.base());
-      }
-      else
+      if (k->lazy() && !k->greedy() && !k->accept())
       {
-        break; // ++p;
+        Follow::const_iterator i = followpos.find(k->pos());
+        if (i != followpos.end())
+          lazy_followpos(followpos, i, *k);
       }
-#else
-      if (!p->greedy()) // stop here, greedy bit is 0 from here on
-        break;
-      pos.insert(p->lazy(0));
-      pos.erase(--p.base()); // CHECKED 10/21 ++p;
-#endif
     }
+    if (s == back_state)
+      break;
   }
-#if 0 // CHECKED algorithmic options: 7/31 but results in more states
-  while (p != pos.rend() && p->greedy())
+  size_t threads = std::min(opt_.t, frontier.size());
+  // the arenas of the workers are deleted after the moves, they count to the bytes of the budget with the arena of the pattern
+  Worker::Arenas arenas(threads);
+  Mutex mutex;
+  std::vector<Moves> moves;
+  std::vector<std::vector<size_t> > hashes(frontier.size());
+  moves.reserve(frontier.size());
+  for (size_t i = 0; i < frontier.size(); ++i)
   {
-    pos.insert(p->greedy(false));
-    pos.erase(--p.base());
+    // the moves of a state are allocated in the arena of the worker that computes them
+    Arena::Scope scope(arenas.arena[i % threads]);
+    moves.push_back(Moves());
   }
-#endif
-  // trims accept positions keeping the first only, and keeping redo (positions with accept == 0)
-  Positions::iterator q = pos.begin(), a = pos.end();
-  while (q != pos.end())
+  std::vector<Worker> workers(threads);
+  for (size_t w = 0; w < threads; ++w)
+  {
+    Worker& worker = workers[w];
+    worker.pattern = this;
+    worker.frontier = &frontier;
+    worker.first = w;
+    worker.step = threads;
+    worker.followpos = &followpos;
+    worker.modifiers = &modifiers;
+    worker.lookahead = &lookahead;
+    worker.alphabet = &alphabet;
+    worker.moves = &moves;
+    worker.hashes = &hashes;
+    worker.arena = arenas.arena[w];
+    worker.mutex = &mutex;
+  }
+  // this thread runs the first worker, a worker that cannot be started in a thread of its own is run by this thread after the first
+#if (defined(__WIN32__) || defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(__BORLANDC__)) && !defined(__CYGWIN__) && !defined(__MINGW32__) && !defined(__MINGW64__)
+  std::vector<HANDLE> thread(threads, NULL);
+  for (size_t w = 1; w < threads; ++w)
+    thread[w] = ::CreateThread(NULL, 0, &Worker::start, &workers[w], 0, NULL);
+  workers[0].run();
+  for (size_t w = 1; w < threads; ++w)
   {
-    if (q->accept() && q->accepts() != 0)
+    if (thread[w] != NULL)
     {
-      if (a == pos.end())
-        a = q++;
-      else
-        pos.erase(q++);
+      ::WaitForSingleObject(thread[w], INFINITE);
+      ::CloseHandle(thread[w]);
     }
     else
     {
-      ++q;
+      workers[w].run();
     }
   }
-#ifdef DEBUG
-  DBGLOG("END trim_lazy({");
-  for (Positions::const_iterator q = pos.begin(); q != pos.end(); ++q)
-    DBGLOGPOS(*q);
-  DBGLOGA(" })");
+#else
+  std::vector<pthread_t> thread(threads);
+  std::vector<bool> started(threads, false);
+  for (size_t w = 1; w < threads; ++w)
+    started[w] = ::pthread_create(&thread[w], NULL, &Worker::start, &workers[w]) == 0;
+  workers[0].run();
+  for (size_t w = 1; w < threads; ++w)
+  {
+    if (started[w])
+      ::pthread_join(thread[w], NULL);
+    else
+      workers[w].run();
+  }
 #endif
+  ems_ += timer_elapsed(et);
+  check_budget(states.count, arenas.used());
+  // the target states are constructed in the same order as the states constructed one by one without threads
+  for (size_t i = 0; i < frontier.size(); ++i)
+  {
+    State *s = frontier[i];
+    std::vector<size_t>::const_iterator hash = hashes[i].begin();
+    for (Moves::iterator j = moves[i].begin(); j != moves[i].end(); ++j, ++hash)
+    {
+      if (!j->second.empty())
+      {
+        State *target_state = compile_state(states, back_state, j->second, *hash);
+        eno_ += compile_edges(s, j->first, target_state);
+      }
+    }
+    if (s->accept > 0 && s->accept <= end_.size())
+      acc_[s->accept - 1] = true;
+    ++vno_;
+  }
+  DBGLOG("END compile_frontier()");
+  return frontier.back();
 }
 
-void Pattern::compile_transition(
-    State     *state,
-    Follow&    followpos,
-    const Map& modifiers,
-    const Map& lookahead,
-    Moves&     moves) const
+void Pattern::lazy_init(size_t max)
 {
-  DBGLOG("BEGIN compile_transition()");
-  Positions::const_iterator end = state->end();
-  for (Positions::const_iterator k = state->begin(); k != end; ++k)
+  DBGLOG("BEGIN lazy_init()");
+  // DFA states are constructed on demand by the matcher, starting with the start state
+  // the positions and states are kept in an arena that lives as long as the lazy DFA
+  Arena *lazy_arena = new Arena;
+  Arena::Scope lazy_scope(lazy_arena);
+  lzy_ = new Lazy(max, lazy_arena);
+  parse(lzy_->startpos, lzy_->followpos, lzy_->modifiers, lzy_->lookahead);
+  compile_alphabet(lzy_->followpos, lzy_->modifiers, lzy_->alphabet);
+  acc_.assign(end_.size(), true);
+  opc_ = lzy_->code;
+  timer_type t;
+  timer_start(t);
+  lazy_flush();
+  vms_ = timer_elapsed(t);
+  ems_ = 0.0;
+  wms_ = 0.0;
+  pre_.clear();
+  fno_ = 0;
+  ndl_.clear();
+  nmn_ = 0;
+  nmx_ = 0;
+  nnl_ = false;
+  DBGLOG("END lazy_init()");
+}
+
+bool Pattern::lazy_state(State *state) const
+{
+  DBGLOG("BEGIN lazy_state()");
+  Lazy& lazy = *lzy_;
+  Moves moves;
+  compile_transition(
+      state,
+      lazy.followpos,
+      lazy.modifiers,
+      lazy.lookahead,
+      lazy.alphabet,
+      moves);
+  State *back_state = lazy.back;
+  for (Moves::iterator i = moves.begin(); i != moves.end(); ++i)
   {
-    if (k->accept())
+    Positions& pos = i->second;
+    trim_lazy(pos);
+    if (!pos.empty())
     {
-      Index accept = k->accepts();
-      if (state->accept == 0 || accept < state->accept)
-        state->accept = accept; // pick lowest nonzero accept index
-      if (accept == 0)
-        state->redo = true;
+      State *target_state = compile_state(lazy.states, lazy.back, pos);
+      eno_ += compile_edges(state, i->first, target_state);
     }
-    else
+  }
+  compact_edges(state);
+  Index index = nop_;
+  size_t n = nop_ + encode_size(state);
+  // a new state is not constructed until the matcher reaches its stub placed after this state
+  for (State *new_state = back_state->next; new_state; new_state = new_state->next)
+  {
+    if (n >= lazy.max)
+      return false;
+    new_state->index = static_cast<Index>(n);
+    lazy.stubs[new_state->index] = new_state;
+    lazy.code[n++] = opcode_lazy();
+  }
+  if (n > lazy.max)
+    return false;
+  std::map<Index,std::vector<Index> >::iterator ref = lazy.refs.find(state->index);
+  state->index = index;
+  Index end = encode_state(state, lazy.code, index);
+  nop_ = static_cast<Index>(n);
+  // update the GOTO opcodes to the stub of this state
+  if (ref != lazy.refs.end())
+  {
+    for (std::vector<Index>::const_iterator i = ref->second.begin(); i != ref->second.end(); ++i)
+      lazy.code[*i] = (lazy.code[*i] & 0xFFFF0000) | index;
+    lazy.refs.erase(ref);
+  }
+  ++vno_;
+  // record the GOTO opcodes to stubs, which follow the TAKE, REDO, TAIL and HEAD opcodes
+  Index pc = index + static_cast<Index>(state->heads.size() + state->tails.size() + (state->accept > 0 || state->redo));
+  for (; pc < end; ++pc)
+  {
+    Index target_index = index_of(lazy.code[pc]);
+    std::map<Index,State*>::const_iterator stub = lazy.stubs.find(target_index);
+    if (stub != lazy.stubs.end() && stub->second->index == target_index)
+      lazy.refs[target_index].push_back(pc);
+  }
+  // the matcher takes meta edges without checking for stubs, construct their target states now
+  for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+  {
+#if WITH_COMPACT_DFA == -1
+    Char lo = i->first;
+#else
+    Char lo = i->second.first;
+#endif
+    State *target_state = i->second.second;
+    if (is_meta(lo) && target_state != NULL)
     {
-      Location loc = k->loc();
-      Char c = at(loc);
-      DBGLOGN("At %lu: %c", loc, c);
-      bool literal = is_modified('q', modifiers, loc);
-      if (c == '/' && opt_.l && !literal)
-      {
+      std::map<Index,State*>::const_iterator stub = lazy.stubs.find(target_state->index);
+      if (stub != lazy.stubs.end() && stub->second == target_state && !lazy_state(target_state))
+        return false;
+    }
+  }
+  DBGLOG("END lazy_state()");
+  return true;
+}
+
+void Pattern::lazy_flush() const
+{
+  DBGLOG("BEGIN lazy_flush()");
+  Lazy& lazy = *lzy_;
+  Arena::Scope scope(lazy.arena);
+  while (lazy.start)
+  {
+    State *next_state = lazy.start->next;
+    delete lazy.start;
+    lazy.start = next_state;
+  }
+  lazy.start = lazy.back = new State(lazy.startpos);
+  lazy.stubs.clear();
+  lazy.refs.clear();
+  nop_ = 0;
+  vno_ = 0;
+  eno_ = 0;
+  trim_lazy(*lazy.start);
+  lazy.states.clear();
+  lazy.states.insert(lazy.start, hash_positions(*lazy.start));
+  if (!lazy_state(lazy.start))
+    throw regex_error(regex_error::exceeds_limits, rex_.c_str());
+  DBGLOG("END lazy_flush()");
+}
+
+Pattern::Index Pattern::lazy_goto(Index index) const
+{
+  // the caller holds lzy_->mutex, see Matcher::match
+  Arena::Scope scope(lzy_->arena);
+  State *state = lzy_->stubs[index];
+  if (state->index == index && !lazy_state(state))
+  {
+    // the opcode table is full, flush it and construct the start state and this state again
+    Positions pos(*state);
+    lazy_flush();
+    State *back_state = lzy_->back;
+    state = compile_state(lzy_->states, lzy_->back, pos);
+    std::map<Index,State*>::const_iterator stub = lzy_->stubs.find(state->index);
+    bool stubbed = stub != lzy_->stubs.end() && stub->second == state;
+    if ((stubbed || lzy_->back != back_state) && !lazy_state(state))
+      throw regex_error(regex_error::exceeds_limits, rex_.c_str());
+  }
+  return state->index;
+}
+
+void Pattern::compile_literals(
+    State&                          start,
+    const std::vector<std::string>& literals)
+{
+  DBGLOG("BEGIN compile_literals()");
+  State *back_state = &start;
+  vno_ = 1;
+  eno_ = 0;
+  ems_ = 0.0;
+  timer_type vt;
+  timer_start(vt);
+  acc_.resize(end_.size(), false);
+  for (size_t k = 0; k < literals.size(); ++k)
+  {
+    State *state = &start;
+    for (std::string::const_iterator i = literals[k].begin(); i != literals[k].end(); ++i)
+    {
+      Char c = static_cast<unsigned char>(*i);
+      State::Edges::iterator edge = state->edges.find(c);
+      if (edge == state->edges.end())
+      {
+        back_state = back_state->next = new State(Positions());
+        state->edges[c] = std::pair<Char,State*>(c, back_state);
+        state = back_state;
+        ++vno_;
+        ++eno_;
+      }
+      else
+      {
+        state = edge->second.second;
+      }
+    }
+    // the first of duplicate strings is accepted, the same as picking the lowest accept index
+    if (state->accept == 0)
+    {
+      state->accept = static_cast<Index>(k + 1);
+      acc_[k] = true;
+    }
+  }
+  vms_ = timer_elapsed(vt);
+  DBGLOG("END compile_literals()");
+}
+
+void Pattern::compile_literals_find(const std::vector<std::string>& literals)
+{
+  // the unanchored search DFA is not needed when generating code with option f
+  if (!opt_.f.empty() || vno_ > FIND_DFA_MAX)
+    return;
+  DBGLOG("BEGIN compile_literals_find()");
+  // Aho-Corasick automaton: a trie of the strings with failure transitions made explicit
+  State start((Positions()));
+  State *back_state = &start;
+  std::vector<State*> states(1, &start);
+  std::vector<std::vector<State*> > delta(1, std::vector<State*>(256, static_cast<State*>(NULL)));
+  for (size_t k = 0; k < literals.size(); ++k)
+  {
+    size_t state = 0;
+    for (std::string::const_iterator i = literals[k].begin(); i != literals[k].end(); ++i)
+    {
+      unsigned char c = static_cast<unsigned char>(*i);
+      State *next_state = delta[state][c];
+      if (next_state == NULL)
+      {
+        back_state = back_state->next = delta[state][c] = new State(Positions());
+        back_state->index = static_cast<Index>(states.size());
+        states.push_back(back_state);
+        delta.push_back(std::vector<State*>(256, static_cast<State*>(NULL)));
+        next_state = back_state;
+      }
+      state = next_state->index;
+    }
+    if (states[state]->accept == 0)
+      states[state]->accept = static_cast<Index>(k + 1);
+  }
+  // breadth-first to compute the failure transitions from the transitions of the shallower fail states
+  std::vector<size_t> fail(states.size(), 0);
+  std::vector<size_t> queue;
+  for (Char c = 0; c < 256; ++c)
+  {
+    if (delta[0][c] == NULL)
+      delta[0][c] = &start; // restart the search
+    else if (delta[0][c] != &start)
+      queue.push_back(delta[0][c]->index);
+  }
+  for (size_t i = 0; i < queue.size(); ++i)
+  {
+    size_t state = queue[i];
+    if (states[state]->accept == 0)
+      states[state]->accept = states[fail[state]]->accept;
+    for (Char c = 0; c < 256; ++c)
+    {
+      State *next_state = delta[state][c];
+      if (next_state == NULL)
+      {
+        delta[state][c] = delta[fail[state]][c];
+      }
+      else
+      {
+        fail[next_state->index] = delta[fail[state]][c]->index;
+        queue.push_back(next_state->index);
+      }
+    }
+  }
+  for (size_t state = 0; state < states.size(); ++state)
+  {
+    Char lo = 0;
+    for (Char c = 1; c <= 256; ++c)
+    {
+      if (c == 256 || delta[state][c] != delta[state][lo])
+      {
+        Chars chars;
+        chars.insert(lo, c - 1);
+        compile_edges(states[state], chars, delta[state][lo]);
+        lo = c;
+      }
+    }
+  }
+  Index nfo = 0;
+  Opcode *fop = encode_dfa(start, nfo);
+  if (fop)
+  {
+    fop_ = fop;
+    nfo_ = nfo;
+  }
+  delete_dfa(start);
+  DBGLOG("END compile_literals_find()");
+}
+
+void Pattern::compile_reverse()
+{
+  // the reverse DFA is used with the unanchored search DFA only
+  if (!fop_ || !opc_)
+    return;
+  DBGLOG("BEGIN compile_reverse()");
+  // decode the DFA opcode table into edges [lo,hi] to target states, numbered in breadth-first order
+  typedef ReverseEdge Edge;
+  std::map<Index,size_t> node;
+  std::vector<Index> code(1, 0);
+  std::vector<std::vector<Edge> > out;
+  std::vector<bool> acc;
+  node[0] = 0;
+  for (size_t n = 0; n < code.size(); ++n)
+  {
+    if (n >= FIND_DFA_MAX)
+      return;
+    out.push_back(std::vector<Edge>());
+    acc.push_back(false);
+    const Opcode *pc = opc_ + code[n];
+    bool seen[256];
+    size_t covered = 0;
+    std::memset(seen, 0, sizeof(seen));
+    while (covered < 256)
+    {
+      Opcode opcode = *pc++;
+      if (is_opcode_dense(opcode))
+        continue;
+      if (is_opcode_redo(opcode) || is_opcode_tail(opcode) || is_opcode_head(opcode))
+        return;
+      if (is_opcode_take(opcode))
+      {
+        acc[n] = true;
+        continue;
+      }
+      if (is_opcode_meta(opcode))
+        return;
+      Index index = index_of(opcode);
+      if (is_opcode_long(opcode))
+        index = long_index_of(*pc++);
+      Char lo = lo_of(opcode);
+      Char hi = hi_of(opcode);
+      for (Char c = lo; c <= hi; ++c)
+      {
+        if (seen[c])
+          continue;
+        seen[c] = true;
+        ++covered;
+        if (index == IMAX)
+          continue;
+        std::pair<std::map<Index,size_t>::iterator,bool> target = node.insert(std::pair<Index,size_t>(index, code.size()));
+        if (target.second)
+          code.push_back(index);
+        if (!out[n].empty() && out[n].back().hi + 1 == c && out[n].back().to == target.first->second)
+        {
+          out[n].back().hi = c;
+        }
+        else
+        {
+          Edge e = { c, c, target.first->second };
+          out[n].push_back(e);
+        }
+      }
+    }
+  }
+  size_t nodes = code.size();
+  // useful states lead to an accepting state
+  std::vector<bool> useful(acc);
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (size_t n = 0; n < nodes; ++n)
+    {
+      if (useful[n])
+        continue;
+      for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+      {
+        if (useful[e->to])
+        {
+          useful[n] = changed = true;
+          break;
+        }
+      }
+    }
+  }
+  // subset construction of the reverse DFA: its states are the sets of states from which the remaining input
+  // up to the end of a match leads to a useful state, a match may begin where the set contains the start state
+  Positions startpos;
+  for (size_t n = 0; n < nodes; ++n)
+    if (useful[n])
+      startpos.insert(Position(n));
+  State start(startpos);
+  State *back_state = &start;
+  States states;
+  states.insert(&start, hash_positions(start));
+  size_t vno = 0;
+  size_t pno = 0;
+  bool ok = true;
+  for (State *state = &start; state; state = state->next)
+  {
+    if (++vno > FIND_DFA_MAX || pno > FIND_POS_MAX)
+    {
+      ok = false;
+      break;
+    }
+    if (state->find(Position(0)) != state->end())
+      state->accept = 1;
+    std::vector<bool> member(nodes, false);
+    for (Positions::const_iterator p = state->begin(); p != state->end(); ++p)
+      member[static_cast<size_t>(*p)] = true;
+    std::vector<Positions> pos(256);
+    for (size_t n = 0; n < nodes; ++n)
+      for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+        if (member[e->to])
+          for (Char c = e->lo; c <= e->hi; ++c, ++pno)
+            pos[c].insert(Position(n));
+    for (Char lo = 0; lo < 256; )
+    {
+      Char hi = lo;
+      while (hi < 255 && pos[hi + 1] == pos[lo])
+        ++hi;
+      if (!pos[lo].empty())
+      {
+        Chars chars;
+        chars.insert(lo, hi);
+        compile_edges(state, chars, compile_state(states, back_state, pos[lo]));
+      }
+      lo = hi + 1;
+    }
+  }
+  if (ok)
+  {
+    compact_dfa(start);
+    Index nro = 0;
+    Opcode *rop = encode_dfa(start, nro);
+    if (rop)
+    {
+      rop_ = rop;
+      nro_ = nro;
+    }
+  }
+  delete_dfa(start);
+  DBGLOG("END compile_reverse()");
+}
+
+void Pattern::compile_find(
+    const Positions& startpos,
+    Follow&          followpos,
+    const Map&       modifiers,
+    const Map&       lookahead,
+    const Alphabet&  alphabet)
+{
+  // the unanchored search DFA is not needed when generating code with option f, nor constructed when the DFA is too large
+  if (!opt_.f.empty() || vno_ > FIND_DFA_MAX)
+    return;
+  DBGLOG("BEGIN compile_find()");
+  // DFA for (?s:.)*X to find the end of the first match in one pass, restarting at every char
+  State start(startpos);
+  State *back_state = &start;
+  // the start state is entered only when no match is in progress, so the start state is not stored in the table
+  States states;
+  size_t vno = 0;
+  size_t pno = 0;
+  bool ok = true;
+  for (State *state = &start; state && ok; state = state->next)
+  {
+    check_budget(vno);
+    // give up when the DFA grows too large or when lazy positions are present
+    if (++vno > FIND_DFA_MAX || pno > FIND_POS_MAX)
+    {
+      ok = false;
+      break;
+    }
+    for (Positions::const_iterator p = state->begin(); p != state->end(); ++p)
+    {
+      if (p->lazy())
+      {
+        ok = false;
+        break;
+      }
+    }
+    if (!ok)
+      break;
+    Moves moves;
+    compile_transition(
+        state,
+        followpos,
+        modifiers,
+        lookahead,
+        alphabet,
+        moves);
+    if (state->redo || !state->heads.empty() || !state->tails.empty())
+    {
+      ok = false;
+      break;
+    }
+    // the search ends at the first accepting state, so its transitions are never taken and are not constructed, which keeps bounded repeats X{n,m} from expanding into the (?s:.)* restarts
+    if (state->accept > 0)
+      continue;
+    // all chars that do not continue a match restart the search at the start state
+    Chars restart;
+    restart.insert(0x00, 0xFF);
+    for (Moves::iterator i = moves.begin(); i != moves.end(); ++i)
+    {
+#if defined(WITH_BITS)
+      if (i->first.find_next(0xFF) != Bits::npos)
+#else
+      if (i->first.rbegin()->second > 0x100)
+#endif
+      {
+        // anchors and word boundaries are not supported by the unanchored search DFA
+        ok = false;
+        break;
+      }
+      restart -= i->first;
+      set_insert(i->second, startpos);
+      pno += i->second.size();
+    }
+    if (!ok)
+      break;
+    for (Moves::iterator i = moves.begin(); i != moves.end(); ++i)
+      compile_edges(state, i->first, compile_state(states, back_state, i->second));
+    if (restart.any())
+      compile_edges(state, restart, &start);
+  }
+  if (ok)
+  {
+    compact_dfa(start);
+    Index nfo = 0;
+    Opcode *fop = encode_dfa(start, nfo);
+    if (fop)
+    {
+      fop_ = fop;
+      nfo_ = nfo;
+    }
+  }
+  delete_dfa(start);
+  DBGLOG("END compile_find()");
+}
+
+#if (defined(__WIN32__) || defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(__BORLANDC__)) && !defined(__CYGWIN__) && !defined(__MINGW32__) && !defined(__MINGW64__)
+Pattern::Mutex::Mutex()
+  :
+    mtx_(new SRWLOCK)
+{
+  ::InitializeSRWLock(static_cast<SRWLOCK*>(mtx_));
+}
+
+Pattern::Mutex::~Mutex()
+{
+  delete static_cast<SRWLOCK*>(mtx_);
+}
+
+void Pattern::Mutex::lock()
+{
+  ::AcquireSRWLockExclusive(static_cast<SRWLOCK*>(mtx_));
+}
+
+void Pattern::Mutex::unlock()
+{
+  ::ReleaseSRWLockExclusive(static_cast<SRWLOCK*>(mtx_));
+}
+#else
+Pattern::Mutex::Mutex()
+  :
+    mtx_(new pthread_mutex_t)
+{
+  ::pthread_mutex_init(static_cast<pthread_mutex_t*>(mtx_), NULL);
+}
+
+Pattern::Mutex::~Mutex()
+{
+  ::pthread_mutex_destroy(static_cast<pthread_mutex_t*>(mtx_));
+  delete static_cast<pthread_mutex_t*>(mtx_);
+}
+
+void Pattern::Mutex::lock()
+{
+  ::pthread_mutex_lock(static_cast<pthread_mutex_t*>(mtx_));
+}
+
+void Pattern::Mutex::unlock()
+{
+  ::pthread_mutex_unlock(static_cast<pthread_mutex_t*>(mtx_));
+}
+#endif
+
+#if (defined(__WIN32__) || defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(__BORLANDC__)) && !defined(__CYGWIN__) && !defined(__MINGW32__) && !defined(__MINGW64__)
+static __declspec(thread) void *current_arena = NULL;
+#elif __cplusplus >= 201103L
+static thread_local void *current_arena = NULL;
+#else
+static __thread void *current_arena = NULL;
+#endif
+
+Pattern::Arena *Pattern::Arena::current()
+{
+  return static_cast<Arena*>(current_arena);
+}
+
+void Pattern::Arena::current(Arena *arena)
+{
+  current_arena = arena;
+}
+
+Pattern::Arena::~Arena()
+{
+  while (blk_ != NULL)
+  {
+    char *next = *reinterpret_cast<char**>(blk_);
+    ::operator delete(blk_);
+    blk_ = next;
+  }
+  while (big_ != NULL)
+  {
+    void **next = static_cast<void**>(big_[1]);
+    ::operator delete(big_);
+    big_ = next;
+  }
+}
+
+void *Pattern::Arena::alloc(size_t size)
+{
+  if (size > SMAX)
+  {
+    // a larger size is prefixed with the links of a list, to release it with the arena
+    void **big = static_cast<void**>(::operator new(size + ALIGN));
+    use_ += size + ALIGN;
+    big[0] = NULL;
+    big[1] = big_;
+    if (big_ != NULL)
+      big_[0] = big;
+    big_ = big;
+    return reinterpret_cast<char*>(big) + ALIGN;
+  }
+  size_t k = (size + ALIGN - 1) / ALIGN + (size == 0);
+  void *ptr = fre_[k - 1];
+  if (ptr != NULL)
+  {
+    // reuse memory freed before, the free list is linked by the first word
+    fre_[k - 1] = *static_cast<void**>(ptr);
+    return ptr;
+  }
+  size = k * ALIGN;
+  if (ptr_ == NULL || static_cast<size_t>(end_ - ptr_) < size)
+  {
+    // a new block starts with a pointer to the previous block
+    char *block = static_cast<char*>(::operator new(BLOCK));
+    use_ += BLOCK;
+    *reinterpret_cast<char**>(block) = blk_;
+    blk_ = block;
+    ptr_ = block + ALIGN;
+    end_ = block + BLOCK;
+  }
+  ptr = ptr_;
+  ptr_ += size;
+  return ptr;
+}
+
+void Pattern::Arena::free(
+    void  *ptr,
+    size_t size)
+{
+  if (ptr == NULL)
+    return;
+  if (size > SMAX)
+  {
+    void **big = reinterpret_cast<void**>(static_cast<char*>(ptr) - ALIGN);
+    if (big[0] != NULL)
+      static_cast<void**>(big[0])[1] = big[1];
+    else
+      big_ = static_cast<void**>(big[1]);
+    if (big[1] != NULL)
+      static_cast<void**>(big[1])[0] = big[0];
+    ::operator delete(big);
+    use_ -= size + ALIGN;
+    return;
+  }
+  size_t k = (size + ALIGN - 1) / ALIGN + (size == 0);
+  *static_cast<void**>(ptr) = fre_[k - 1];
+  fre_[k - 1] = ptr;
+}
+
+Pattern::State *Pattern::compile_state(
+    States&          states,
+    State          *&back_state,
+    const Positions& pos,
+    size_t           hash) const
+{
+  State *target_state = states.find(pos, hash);
+  if (!target_state)
+  {
+    back_state = back_state->next = target_state = new State(pos);
+    states.insert(target_state, hash);
+  }
+  return target_state;
+}
+
+size_t Pattern::hash_positions(const Positions& pos)
+{
+  uint64_t h = pos.size();
+  for (Positions::const_iterator p = pos.begin(); p != pos.end(); ++p)
+  {
+    h ^= p->k + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    h *= 0xFF51AFD7ED558CCDULL;
+  }
+  return static_cast<size_t>(h ^ (h >> 32));
+}
+
+Pattern::State *Pattern::States::find(
+    const Positions& pos,
+    size_t           hash) const
+{
+  size_t mask = table.size() - 1;
+  for (size_t i = hash & mask; table[i]; i = (i + 1) & mask)
+    if (table[i]->hash == hash && *table[i] == pos)
+      return table[i];
+  return NULL;
+}
+
+void Pattern::States::insert(
+    State *state,
+    size_t hash)
+{
+  state->hash = hash;
+  if (2 * (count + 1) > table.size())
+  {
+    // double the table and reinsert the states
+    std::vector<State*> old(2 * table.size(), NULL);
+    old.swap(table);
+    size_t mask = table.size() - 1;
+    for (std::vector<State*>::const_iterator j = old.begin(); j != old.end(); ++j)
+    {
+      if (*j)
+      {
+        size_t i = (*j)->hash & mask;
+        while (table[i])
+          i = (i + 1) & mask;
+        table[i] = *j;
+      }
+    }
+  }
+  size_t mask = table.size() - 1;
+  size_t i = hash & mask;
+  while (table[i])
+    i = (i + 1) & mask;
+  table[i] = state;
+  ++count;
+}
+
+size_t Pattern::compile_edges(
+    State       *state,
+    const Chars& chars,
+    State       *target_state) const
+{
+  size_t eno = 0;
+#if defined(WITH_BITS)
+  Char lo = chars.find_first(), j = lo, k = lo;
+  for (;;)
+  {
+    if (j != k)
+    {
+      Char hi = k - 1;
+#if WITH_COMPACT_DFA == -1
+      state->edges[lo] = std::pair<Char,State*>(hi, target_state);
+#else
+      state->edges[hi] = std::pair<Char,State*>(lo, target_state);
+#endif
+      lo = k = j;
+    }
+    if (j == Bits::npos)
+      break;
+    j = chars.find_next(j);
+    ++k;
+    ++eno;
+  }
+#else
+  for (Chars::const_iterator j = chars.begin(); j != chars.end(); ++j)
+  {
+    Char lo = j->first;
+    Char hi = j->second - 1; // -1 to adjust open ended [lo,hi)
+#if WITH_COMPACT_DFA == -1
+    state->edges[lo] = std::pair<Char,State*>(hi, target_state);
+#else
+    state->edges[hi] = std::pair<Char,State*>(lo, target_state);
+#endif
+    eno += hi - lo + 1;
+  }
+#endif
+  return eno;
+}
+
+void Pattern::lazy(
+    const Positions& lazypos,
+    Positions&       pos) const
+{
+  if (!lazypos.empty())
+  {
+    Positions pos1;
+    lazy(lazypos, pos, pos1);
+    pos.swap(pos1);
+  }
+}
+
+void Pattern::lazy(
+    const Positions& lazypos,
+    const Positions& pos,
+    Positions&       pos1) const
+{
+  for (Positions::const_iterator p = pos.begin(); p != pos.end(); ++p)
+    for (Positions::const_iterator q = lazypos.begin(); q != lazypos.end(); ++q)
+      // pos1.insert(p->lazy() ? *p : p->lazy(q->loc())); // CHECKED algorithmic options: only if p is not already lazy??
+      pos1.insert(p->lazy(q->loc())); // overrides lazyness even when p is already lazy
+}
+
+void Pattern::greedy(Positions& pos) const
+{
+  Positions pos1;
+  for (Positions::const_iterator p = pos.begin(); p != pos.end(); ++p)
+    pos1.insert(p->lazy() ? *p : p->greedy(true)); // CHECKED algorithmic options: 7/29 guard added: p->lazy() ? *p : p->greedy(true)
+    // CHECKED 10/21 pos1.insert(p->lazy(0).greedy(true));
+  pos.swap(pos1);
+}
+
+void Pattern::trim_lazy(Positions& pos) const
+{
+#ifdef DEBUG
+  DBGLOG("BEGIN trim_lazy({");
+  for (Positions::const_iterator q = pos.begin(); q != pos.end(); ++q)
+    DBGLOGPOS(*q);
+  DBGLOGA(" })");
+#endif
+  // lazy positions are last in the sorted positions, trim them from the back and merge the non-lazy positions they produce
+  Positions pos1;
+  size_t n = pos.size();
+  while (n > 0 && pos[n - 1].lazy())
+  {
+    const Position p = pos[n - 1];
+    Location l = p.lazy();
+    if (p.accept() || p.anchor()) // CHECKED algorithmic options: 7/28 added p->anchor()
+    {
+      pos1.insert(p.lazy(0)); // make lazy accept/anchor a non-lazy accept/anchor
+      --n;
+      while (n > 0 && !pos[n - 1].accept() && pos[n - 1].lazy() == l)
+        --n;
+    }
+    else
+    {
+      if (!p.greedy()) // stop here, greedy bit is 0 from here on
+        break;
+      pos1.insert(p.lazy(0));
+      --n; // CHECKED 10/21 ++p;
+    }
+  }
+  pos.resize(n);
+  set_insert(pos, pos1);
+  // trims accept positions keeping the first only, and keeping redo (positions with accept == 0)
+  Positions::iterator q = pos.begin();
+  bool accept = false;
+  for (Positions::const_iterator p = pos.begin(); p != pos.end(); ++p)
+  {
+    if (p->accept() && p->accepts() != 0)
+    {
+      if (accept)
+        continue;
+      accept = true;
+    }
+    *q++ = *p;
+  }
+  pos.erase(q, pos.end());
+#ifdef DEBUG
+  DBGLOG("END trim_lazy({");
+  for (Positions::const_iterator q = pos.begin(); q != pos.end(); ++q)
+    DBGLOGPOS(*q);
+  DBGLOGA(" })");
+#endif
+}
+
+Pattern::Follow::const_iterator Pattern::lazy_followpos(
+    Follow&                followpos,
+    Follow::const_iterator i,
+    Position               k) const
+{
+  Follow::iterator j = followpos.find(k);
+  if (j == followpos.end())
+  {
+    // followpos is not defined for lazy pos yet, so add lazy followpos (memoization)
+    j = followpos.insert(std::pair<Position,Positions>(k, Positions())).first;
+    for (Positions::const_iterator p = i->second.begin(); p != i->second.end(); ++p)
+      j->second.insert(/* p->lazy() || CHECKED algorithmic options: 7/31 */ p->ticked() ? *p : /* CHECKED algorithmic options: 7/31 adds too many states p->greedy() ? p->lazy(0).greedy(false) : */ p->lazy(k.lazy())); // CHECKED algorithmic options: 7/18 ticked() preserves lookahead tail at '/' and ')'
+#ifdef DEBUG
+    DBGLOGN("lazy followpos(");
+    DBGLOGPOS(k);
+    DBGLOGA(" ) = {");
+    for (Positions::const_iterator q = j->second.begin(); q != j->second.end(); ++q)
+      DBGLOGPOS(*q);
+    DBGLOGA(" }");
+#endif
+  }
+  return j;
+}
+
+void Pattern::compile_transition(
+    State          *state,
+    Follow&         followpos,
+    const Map&      modifiers,
+    const Map&      lookahead,
+    const Alphabet& alphabet,
+    Moves&          moves,
+    Mutex          *mutex) const
+{
+  DBGLOG("BEGIN compile_transition()");
+  // the positions with chars and the positions that move on each char class, classes moved by the same positions are moved together
+  std::vector<const Positions*> follows;
+  std::vector<std::vector<Index> > movers(alphabet.lo.size());
+  Set heads;
+  Set tails;
+  Positions::const_iterator end = state->end();
+  for (Positions::const_iterator k = state->begin(); k != end; ++k)
+  {
+    if (k->accept())
+    {
+      Index accept = k->accepts();
+      if (state->accept == 0 || accept < state->accept)
+        state->accept = accept; // pick lowest nonzero accept index
+      if (accept == 0)
+        state->redo = true;
+    }
+    else
+    {
+      Location loc = k->loc();
+      Char c = at(loc);
+      DBGLOGN("At %lu: %c", loc, c);
+      bool literal = is_modified('q', modifiers, loc);
+      if (c == '/' && opt_.l && !literal)
+      {
         Position n(0);
         DBGLOG("LOOKAHEAD");
         for (Map::const_iterator i = lookahead.begin(); i != lookahead.end(); ++i)
@@ -1303,9 +2529,9 @@ void Pattern::compile_transition(
           if (j != i->second.end())
           {
             if (!k->ticked())
-              state->heads.insert(static_cast<Index>(n + std::distance(i->second.begin(), j)));
+              heads.insert(static_cast<Index>(n + std::distance(i->second.begin(), j)));
             else // CHECKED algorithmic options: 7/18 if (state->accept == i->first) no longer check for accept state, assume we are at an accept state
-              state->tails.insert(static_cast<Index>(n + std::distance(i->second.begin(), j)));
+              tails.insert(static_cast<Index>(n + std::distance(i->second.begin(), j)));
           }
           n = n + i->second.size();
         }
@@ -1319,7 +2545,7 @@ void Pattern::compile_transition(
           Locations::const_iterator j = i->second.find(loc);
           DBGLOGN("%d %d (%d) %lu", state->accept, i->first, j != i->second.end(), n.loc());
           if (j != i->second.end())
-            state->heads.insert(static_cast<Index>(n + std::distance(i->second.begin(), j)));
+            heads.insert(static_cast<Index>(n + std::distance(i->second.begin(), j)));
           n = n + i->second.size();
         }
       }
@@ -1336,7 +2562,7 @@ void Pattern::compile_transition(
             Locations::const_iterator j = i->second.find(loc);
             DBGLOGN("%d %d (%d) %lu", state->accept, i->first, j != i->second.end(), n.loc());
             if (j != i->second.end() /* CHECKED algorithmic options: 7/18 && state->accept == i->first */ ) // only add lookstop when part of the proper accept state
-              state->tails.insert(static_cast<Index>(n + std::distance(i->second.begin(), j)));
+              tails.insert(static_cast<Index>(n + std::distance(i->second.begin(), j)));
             n = n + i->second.size();
           }
         }
@@ -1352,174 +2578,205 @@ void Pattern::compile_transition(
             if (k->greedy())
               continue;
 #endif
-            Follow::iterator j = followpos.find(*k);
-            if (j == followpos.end())
-            {
-              // followpos is not defined for lazy pos yet, so add lazy followpos (memoization)
-              j = followpos.insert(std::pair<Position,Positions>(*k, Positions())).first;
-              for (Positions::const_iterator p = i->second.begin(); p != i->second.end(); ++p)
-                j->second.insert(/* p->lazy() || CHECKED algorithmic options: 7/31 */ p->ticked() ? *p : /* CHECKED algorithmic options: 7/31 adds too many states p->greedy() ? p->lazy(0).greedy(false) : */ p->lazy(k->lazy())); // CHECKED algorithmic options: 7/18 ticked() preserves lookahead tail at '/' and ')'
-#ifdef DEBUG
-              DBGLOGN("lazy followpos(");
-              DBGLOGPOS(*k);
-              DBGLOGA(" ) = {");
-              for (Positions::const_iterator q = j->second.begin(); q != j->second.end(); ++q)
-                DBGLOGPOS(*q);
-              DBGLOGA(" }");
-#endif
-            }
-            i = j;
+            i = lazy_followpos(followpos, i, *k);
           }
           const Positions &follow = i->second;
-          Chars chars;
-          if (literal)
+          Alphabet::Ids::const_iterator ids = alphabet.ids.find(Position(loc).anchor(k->anchor()));
+          if (ids == alphabet.ids.end())
+            ids = alphabet.ids.find(Position(loc));
+          if (ids != alphabet.ids.end())
           {
-            chars.insert(c);
+            Index mover = static_cast<Index>(follows.size());
+            follows.push_back(&follow);
+            for (Alphabet::Classes::const_iterator j = ids->second.begin(); j != ids->second.end(); ++j)
+              movers[*j].push_back(mover);
           }
-          else
+        }
+      }
+    }
+  }
+  if (!heads.empty() || !tails.empty())
+  {
+    Mutex::Scope lock(mutex);
+    set_insert(state->heads, heads);
+    set_insert(state->tails, tails);
+  }
+  std::map<const std::vector<Index>*,Move*,IndirectLess<std::vector<Index> > > move;
+  for (Index j = 0; j + 1 < alphabet.lo.size(); ++j)
+  {
+    if (movers[j].empty())
+      continue;
+    std::map<const std::vector<Index>*,Move*,IndirectLess<std::vector<Index> > >::iterator i = move.find(&movers[j]);
+    if (i == move.end())
+    {
+      moves.push_back(Move());
+      for (std::vector<Index>::const_iterator mover = movers[j].begin(); mover != movers[j].end(); ++mover)
+        set_insert(moves.back().second, *follows[*mover]);
+      i = move.insert(std::pair<const std::vector<Index>*,Move*>(&movers[j], &moves.back())).first;
+    }
+    i->second->first.insert(alphabet.lo[j], alphabet.lo[j + 1] - 1);
+  }
+  DBGLOG("END compile_transition()");
+}
+
+void Pattern::compile_chars(
+    Position   k,
+    const Map& modifiers,
+    Chars&     chars) const
+{
+  Location loc = k.loc();
+  Char c = at(loc);
+  bool literal = is_modified('q', modifiers, loc);
+  if (literal)
+  {
+    chars.insert(c);
+  }
+  else
+  {
+    switch (c)
+    {
+      case '.':
+        if (is_modified('s', modifiers, loc))
+        {
+          chars.insert(0, 0xFF);
+        }
+        else
+        {
+          chars.insert(0, 9);
+          chars.insert(11, 0xFF);
+        }
+        break;
+      case '^':
+        chars.insert(is_modified('m', modifiers, loc) ? META_BOL : META_BOB);
+        break;
+      case '$':
+        chars.insert(is_modified('m', modifiers, loc) ? META_EOL : META_EOB);
+        break;
+      default:
+        if (c == '[' && !escapes_at(loc, "AzBb<>ij"))
+        {
+          compile_list(loc + 1, chars, modifiers);
+        }
+        else
+        {
+          switch (escape_at(loc))
           {
-            switch (c)
-            {
-              case '.':
-                if (is_modified('s', modifiers, loc))
-                {
-                  chars.insert(0, 0xFF);
-                }
-                else
-                {
-                  chars.insert(0, 9);
-                  chars.insert(11, 0xFF);
-                }
-                break;
-              case '^':
-                chars.insert(is_modified('m', modifiers, loc) ? META_BOL : META_BOB);
-                break;
-              case '$':
-                chars.insert(is_modified('m', modifiers, loc) ? META_EOL : META_EOB);
-                break;
-              default:
-                if (c == '[' && !escapes_at(loc, "AzBb<>ij"))
-                {
-                  compile_list(loc + 1, chars, modifiers);
-                }
-                else
-                {
-                  switch (escape_at(loc))
-                  {
-                    case 'i':
-                      chars.insert(META_IND);
-                      break;
-                    case 'j':
-                      chars.insert(META_DED);
-                      break;
-                    case 'k':
-                      chars.insert(META_UND);
-                      break;
-                    case 'A':
-                      chars.insert(META_BOB);
-                      break;
-                    case 'z':
-                      chars.insert(META_EOB);
-                      break;
-                    case 'B':
-                      chars.insert(k->anchor() ? META_NWB : META_NWE);
-                      break;
-                    case 'b':
-                      if (k->anchor())
-                        chars.insert(META_BWB, META_EWB);
-                      else
-                        chars.insert(META_BWE, META_EWE);
-                      break;
-                    case '<':
-                      chars.insert(k->anchor() ? META_BWB : META_BWE);
-                      break;
-                    case '>':
-                      chars.insert(k->anchor() ? META_EWB : META_EWE);
-                      break;
-                    case '\0': // no escape at current loc
-                      if (std::isalpha(c) && is_modified('i', modifiers, loc))
-                      {
-                        chars.insert(uppercase(c));
-                        chars.insert(lowercase(c));
-                      }
-                      else
-                      {
-                        chars.insert(c);
-                      }
-                      break;
-                    default:
-                      c = compile_esc(loc + 1, chars);
-                      if (c <= 255 && std::isalpha(c) && is_modified('i', modifiers, loc))
-                      {
-                        chars.insert(uppercase(c));
-                        chars.insert(lowercase(c));
-                      }
-                  }
-                }
-            }
+            case 'i':
+              chars.insert(META_IND);
+              break;
+            case 'j':
+              chars.insert(META_DED);
+              break;
+            case 'k':
+              chars.insert(META_UND);
+              break;
+            case 'A':
+              chars.insert(META_BOB);
+              break;
+            case 'z':
+              chars.insert(META_EOB);
+              break;
+            case 'B':
+              chars.insert(k.anchor() ? META_NWB : META_NWE);
+              break;
+            case 'b':
+              if (k.anchor())
+                chars.insert(META_BWB, META_EWB);
+              else
+                chars.insert(META_BWE, META_EWE);
+              break;
+            case '<':
+              chars.insert(k.anchor() ? META_BWB : META_BWE);
+              break;
+            case '>':
+              chars.insert(k.anchor() ? META_EWB : META_EWE);
+              break;
+            case '\0': // no escape at current loc
+              if (std::isalpha(c) && is_modified('i', modifiers, loc))
+              {
+                chars.insert(uppercase(c));
+                chars.insert(lowercase(c));
+              }
+              else
+              {
+                chars.insert(c);
+              }
+              break;
+            default:
+              c = compile_esc(loc + 1, chars);
+              if (c <= 255 && std::isalpha(c) && is_modified('i', modifiers, loc))
+              {
+                chars.insert(uppercase(c));
+                chars.insert(lowercase(c));
+              }
           }
-          transition(moves, chars, follow);
         }
-      }
     }
   }
-  DBGLOG("END compile_transition()");
 }
 
-void Pattern::transition(
-    Moves&           moves,
-    const Chars&     chars,
-    const Positions& follow) const
+void Pattern::compile_alphabet(
+    const Follow& followpos,
+    const Map&    modifiers,
+    Alphabet&     alphabet) const
 {
-  Chars rest = chars;
-  Moves::iterator i = moves.begin();
-  Moves::const_iterator end = moves.end();
-  while (i != end)
+  DBGLOG("BEGIN compile_alphabet()");
+  // the char ranges at each location with a followpos, the lookahead markers at a location have no chars
+  std::map<Position,std::vector<std::pair<Char,Char> > > ranges;
+  for (Follow::const_iterator i = followpos.begin(); i != followpos.end(); ++i)
   {
-    if (i->second == follow)
+    Location loc = i->first.loc();
+    Char c = at(loc);
+    if (!is_modified('q', modifiers, loc) && ((c == '/' && opt_.l) || c == '(' || c == ')'))
+      continue;
+    for (int anchor = 0; anchor < 2; ++anchor)
     {
-      rest |= i->first;
-      moves.erase(i++);
-    }
-    else if (chars.intersects(i->first))
-    {
-      Chars common(chars & i->first);
-      if (is_subset(follow, i->second))
-      {
-        rest -= common;
-        ++i;
-      }
-      else if (i->first == common && is_subset(i->second, follow))
-      {
-        moves.erase(i++);
-      }
-      else
+      // only word boundaries differ by anchor
+      Position k = Position(loc).anchor(anchor != 0);
+      if ((anchor && !escapes_at(loc, "Bb<>")) || ranges.find(k) != ranges.end())
+        continue;
+      Chars chars;
+      compile_chars(k, modifiers, chars);
+      std::vector<std::pair<Char,Char> >& range = ranges[k];
+#if defined(WITH_BITS)
+      for (size_t lo = chars.find_first(); lo != Bits::npos; )
       {
-        rest -= common;
-        i->first -= common;
-        if (i->first.any()) // any bits or ranges?
-        {
-          Move back;
-          back.first.swap(common);
-          back.second = i->second;
-          set_insert(back.second, follow);
-          moves.push_back(back); // faster: C++11 emplace_back(Chars(), i->second); move.back().first.swap(common)
-        }
-        else
-        {
-          i->first.swap(common);
-          set_insert(i->second, follow);
-        }
-        ++i;
+        size_t hi = lo;
+        while (chars.find_next(hi) == hi + 1)
+          ++hi;
+        range.push_back(std::pair<Char,Char>(static_cast<Char>(lo), static_cast<Char>(hi)));
+        lo = chars.find_next(hi);
       }
+#else
+      for (Chars::const_iterator j = chars.begin(); j != chars.end(); ++j)
+        range.push_back(std::pair<Char,Char>(j->first, j->second - 1)); // -1 to adjust open ended [lo,hi)
+#endif
     }
-    else
+  }
+  // the classes are bounded by the lo and hi+1 of all ranges
+  alphabet.lo.clear();
+  for (std::map<Position,std::vector<std::pair<Char,Char> > >::const_iterator i = ranges.begin(); i != ranges.end(); ++i)
+  {
+    for (std::vector<std::pair<Char,Char> >::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
+    {
+      alphabet.lo.push_back(j->first);
+      alphabet.lo.push_back(j->second + 1);
+    }
+  }
+  std::sort(alphabet.lo.begin(), alphabet.lo.end());
+  alphabet.lo.erase(std::unique(alphabet.lo.begin(), alphabet.lo.end()), alphabet.lo.end());
+  alphabet.ids.clear();
+  for (std::map<Position,std::vector<std::pair<Char,Char> > >::const_iterator i = ranges.begin(); i != ranges.end(); ++i)
+  {
+    Alphabet::Classes& ids = alphabet.ids[i->first];
+    for (std::vector<std::pair<Char,Char> >::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
     {
-      ++i;
+      Index id = static_cast<Index>(std::lower_bound(alphabet.lo.begin(), alphabet.lo.end(), j->first) - alphabet.lo.begin());
+      while (alphabet.lo[id] <= j->second)
+        ids.push_back(id++);
     }
   }
-  if (rest.any())
-    moves.push_back(Move(rest, follow)); // faster: C++11 move.emplace_back(rest, follow)
+  DBGLOG("END compile_alphabet()");
 }
 
 Pattern::Char Pattern::compile_esc(Location loc, Chars& chars) const
@@ -1761,194 +3018,597 @@ void Pattern::assemble(State& start)
   DBGLOG("BEGIN assemble()");
   timer_type t;
   timer_start(t);
+  uno_ = vno_;
+  if (opt_.d)
+    minimize_dfa(start);
   export_dfa(start);
   compact_dfa(start);
-  encode_dfa(start);
+  select_dense(start);
+  opc_ = encode_dfa(start, nop_);
+  if (opc_ == NULL)
+    throw regex_error(regex_error::exceeds_limits, rex_.c_str());
+  encode_dense(start);
   gencode_dfa(start);
+  gentable_dfa(start);
   delete_dfa(start);
   export_code();
   wms_ = timer_elapsed(t);
   DBGLOG("END assemble()");
 }
 
+void Pattern::minimize_dfa(State& start)
+{
+  DBGLOG("BEGIN minimize_dfa()");
+  // number the states in depth-first order, adding a dead state for the missing transitions
+  std::vector<State*> states;
+  std::map<const State*,size_t> id;
+  for (State *state = &start; state; state = state->next)
+  {
+    id[state] = states.size();
+    states.push_back(state);
+  }
+  size_t dead = states.size();
+  size_t n = dead + 1;
+  // partition the chars and meta chars into classes of chars that the edges do not distinguish
+  std::set<Char> cuts;
+  for (State *state = &start; state; state = state->next)
+  {
+    for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+    {
+#if WITH_COMPACT_DFA == -1
+      cuts.insert(i->first);
+      cuts.insert(i->second.first + 1);
+#else
+      cuts.insert(i->second.first);
+      cuts.insert(i->first + 1);
+#endif
+    }
+  }
+  std::vector<Char> lows(cuts.begin(), cuts.end());
+  size_t k = lows.empty() ? 0 : lows.size() - 1; // class c covers chars lows[c] to lows[c + 1] - 1
+  // transition table with the dead state as default target
+  std::vector<size_t> trans(n * k, dead);
+  for (size_t s = 0; s < dead; ++s)
+  {
+    for (State::Edges::const_iterator i = states[s]->edges.begin(); i != states[s]->edges.end(); ++i)
+    {
+#if WITH_COMPACT_DFA == -1
+      Char lo = i->first;
+      Char hi = i->second.first;
+#else
+      Char lo = i->second.first;
+      Char hi = i->first;
+#endif
+      size_t t = id[i->second.second];
+      for (size_t c = std::lower_bound(lows.begin(), lows.end(), lo) - lows.begin(); c < k && lows[c] <= hi; ++c)
+        trans[s * k + c] = t;
+    }
+  }
+  // inverse transitions src[off[c * n + t]] to src[off[c * n + t + 1] - 1] are the states going to t on c
+  std::vector<size_t> off(n * k + 1, 0);
+  std::vector<size_t> src(n * k);
+  for (size_t s = 0; s < n; ++s)
+    for (size_t c = 0; c < k; ++c)
+      ++off[c * n + trans[s * k + c] + 1];
+  for (size_t i = 1; i <= n * k; ++i)
+    off[i] += off[i - 1];
+  {
+    std::vector<size_t> pos(off.begin(), off.end() - 1);
+    for (size_t s = 0; s < n; ++s)
+      for (size_t c = 0; c < k; ++c)
+        src[pos[c * n + trans[s * k + c]]++] = s;
+  }
+  // initial partition of the states by accept index, redo, and lookahead head and tail sets
+  typedef std::pair<std::pair<Index,bool>,std::pair<Set,Set> > Key;
+  std::map<Key,size_t> keys;
+  std::vector<size_t> blk(n);
+  for (size_t s = 0; s < n; ++s)
+  {
+    Key key;
+    if (s < dead)
+      key = Key(std::pair<Index,bool>(states[s]->accept, states[s]->redo), std::pair<Set,Set>(states[s]->heads, states[s]->tails));
+    else
+      key = Key(std::pair<Index,bool>(0, false), std::pair<Set,Set>());
+    std::map<Key,size_t>::iterator i = keys.find(key);
+    if (i == keys.end())
+      i = keys.insert(std::pair<Key,size_t>(key, keys.size())).first;
+    blk[s] = i->second;
+  }
+  keys.clear();
+  // refinable partition: block b holds the states elems[first[b]] to elems[last[b] - 1], of which the marked ones come first
+  size_t nb = 0;
+  std::vector<size_t> first(n, 0), last(n, 0), mark(n, 0), elems(n), loc(n);
+  for (size_t s = 0; s < n; ++s)
+  {
+    ++last[blk[s]];
+    if (blk[s] >= nb)
+      nb = blk[s] + 1;
+  }
+  for (size_t b = 0, p = 0; b < nb; ++b)
+  {
+    first[b] = p;
+    p += last[b];
+    last[b] = p;
+  }
+  {
+    std::vector<size_t> pos(first.begin(), first.begin() + nb);
+    for (size_t s = 0; s < n; ++s)
+    {
+      loc[s] = pos[blk[s]]++;
+      elems[loc[s]] = s;
+    }
+  }
+  // Hopcroft's algorithm, initially with all blocks but the largest as splitters
+  std::vector<std::pair<size_t,size_t> > work;
+  std::vector<bool> inwork(n * k, false);
+  size_t largest = 0;
+  for (size_t b = 1; b < nb; ++b)
+    if (last[b] - first[b] > last[largest] - first[largest])
+      largest = b;
+  for (size_t b = 0; b < nb; ++b)
+  {
+    if (b != largest)
+    {
+      for (size_t c = 0; c < k; ++c)
+      {
+        work.push_back(std::pair<size_t,size_t>(b, c));
+        inwork[b * k + c] = true;
+      }
+    }
+  }
+  std::vector<size_t> splitter, touched;
+  while (!work.empty())
+  {
+    size_t a = work.back().first;
+    size_t c = work.back().second;
+    work.pop_back();
+    inwork[a * k + c] = false;
+    splitter.assign(elems.begin() + first[a], elems.begin() + last[a]);
+    touched.clear();
+    // mark the states that go to block a on c
+    for (std::vector<size_t>::const_iterator t = splitter.begin(); t != splitter.end(); ++t)
+    {
+      for (size_t i = off[c * n + *t]; i < off[c * n + *t + 1]; ++i)
+      {
+        size_t s = src[i];
+        size_t b = blk[s];
+        size_t m = first[b] + mark[b];
+        if (loc[s] < m)
+          continue;
+        size_t u = elems[m];
+        elems[loc[s]] = u;
+        loc[u] = loc[s];
+        elems[m] = s;
+        loc[s] = m;
+        if (mark[b]++ == 0)
+          touched.push_back(b);
+      }
+    }
+    // split the touched blocks into their marked and unmarked states
+    for (std::vector<size_t>::const_iterator b = touched.begin(); b != touched.end(); ++b)
+    {
+      size_t m = mark[*b];
+      mark[*b] = 0;
+      if (m == last[*b] - first[*b])
+        continue;
+      first[nb] = first[*b];
+      last[nb] = first[*b] + m;
+      first[*b] = last[nb];
+      for (size_t i = first[nb]; i < last[nb]; ++i)
+        blk[elems[i]] = nb;
+      size_t smaller = m <= last[*b] - first[*b] ? nb : *b;
+      for (size_t d = 0; d < k; ++d)
+      {
+        size_t w = inwork[*b * k + d] ? nb : smaller;
+        work.push_back(std::pair<size_t,size_t>(w, d));
+        inwork[w * k + d] = true;
+      }
+      ++nb;
+    }
+  }
+  // the first state of each block in depth-first order represents the block, the start state is kept
+  std::vector<size_t> rep(nb, n);
+  rep[blk[dead]] = dead;
+  for (size_t s = 0; s < dead; ++s)
+    if (rep[blk[s]] == n)
+      rep[blk[s]] = s;
+  vno_ = 0;
+  eno_ = 0;
+  State *back_state = NULL;
+  for (size_t s = 0; s < dead; ++s)
+  {
+    State *state = states[s];
+    if (s > 0 && rep[blk[s]] != s)
+    {
+      delete state;
+      continue;
+    }
+    for (State::Edges::iterator i = state->edges.begin(); i != state->edges.end();)
+    {
+      size_t b = blk[id[i->second.second]];
+      if (rep[b] == dead)
+      {
+        state->edges.erase(i++);
+      }
+      else
+      {
+        i->second.second = states[rep[b]];
+#if WITH_COMPACT_DFA == -1
+        eno_ += i->second.first - i->first + 1;
+#else
+        eno_ += i->first - i->second.first + 1;
+#endif
+        ++i;
+      }
+    }
+    if (back_state != NULL)
+      back_state->next = state;
+    back_state = state;
+    ++vno_;
+  }
+  back_state->next = NULL;
+  DBGLOG("END minimize_dfa(): %zu states reduced to %zu", uno_, vno_);
+}
+
 void Pattern::compact_dfa(State& start)
+{
+  for (State *state = &start; state; state = state->next)
+    compact_edges(state);
+}
+
+void Pattern::compact_edges(State *state) const
 {
 #if WITH_COMPACT_DFA == -1
   // edge compaction in reverse order
-  for (State *state = &start; state; state = state->next)
+  for (State::Edges::iterator i = state->edges.begin(); i != state->edges.end(); ++i)
   {
-    for (State::Edges::iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+    Char hi = i->second.first;
+    if (hi >= 0xFF)
+      break;
+    State::Edges::iterator j = i;
+    ++j;
+    while (j != state->edges.end() && j->first <= hi + 1)
     {
-      Char hi = i->second.first;
-      if (hi >= 0xFF)
-        break;
-      State::Edges::iterator j = i;
-      ++j;
-      while (j != state->edges.end() && j->first <= hi + 1)
+      hi = j->second.first;
+      if (j->second.second == i->second.second)
       {
-        hi = j->second.first;
-        if (j->second.second == i->second.second)
-        {
-          i->second.first = hi;
-          state->edges.erase(j++);
-        }
-        else
-        {
-          ++j;
-        }
+        i->second.first = hi;
+        state->edges.erase(j++);
+      }
+      else
+      {
+        ++j;
       }
     }
   }
 #elif WITH_COMPACT_DFA == 1
   // edge compaction
-  for (State *state = &start; state; state = state->next)
+  for (State::Edges::reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
   {
-    for (State::Edges::reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+    Char lo = i->second.first;
+    if (lo <= 0x00)
+      break;
+    State::Edges::reverse_iterator j = i;
+    ++j;
+    while (j != state->edges.rend() && j->first >= lo - 1)
     {
-      Char lo = i->second.first;
-      if (lo <= 0x00)
-        break;
-      State::Edges::reverse_iterator j = i;
-      ++j;
-      while (j != state->edges.rend() && j->first >= lo - 1)
+      lo = j->second.first;
+      if (j->second.second == i->second.second)
       {
-        lo = j->second.first;
-        if (j->second.second == i->second.second)
-        {
-          i->second.first = lo;
-          state->edges.erase(--j.base());
-        }
-        else
-        {
-          ++j;
-        }
+        i->second.first = lo;
+        state->edges.erase(--j.base());
+      }
+      else
+      {
+        ++j;
       }
     }
   }
 #else
-  (void)start;
+  (void)state;
 #endif
 }
 
-void Pattern::encode_dfa(State& start)
+void Pattern::select_dense(State& start)
 {
-  nop_ = 0;
+  DBGLOG("BEGIN select_dense()");
+  nds_ = 0;
+  ncl_ = 0;
+  // opcode tables saved with option f are used without a dense transition table
+  if (!opt_.f.empty())
+    return;
+  // chars between two consecutive boundaries of the edges of the dense states form a byte class
+  bool bound[257];
+  std::memset(bound, 0, sizeof(bound));
+  bound[0] = true;
+  bound[256] = true;
+  Index ncl = 1;
   for (State *state = &start; state; state = state->next)
   {
-    state->index = nop_;
-#if WITH_COMPACT_DFA == -1
-    Char hi = 0x00;
+    size_t count = 0;
+    for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+      if (!is_meta(i->first))
+        ++count;
+    if (count < DENSE_EDGES_MIN || nds_ >= LONG)
+      continue;
+    bool next[257];
+    std::memcpy(next, bound, sizeof(next));
+    Index n = ncl;
     for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
     {
+#if WITH_COMPACT_DFA == -1
       Char lo = i->first;
-      if (lo == hi)
-        hi = i->second.first + 1;
-      ++nop_;
+      Char hi = i->second.first;
+#else
+      Char lo = i->second.first;
+      Char hi = i->first;
+#endif
       if (is_meta(lo))
-        nop_ += i->second.first - lo;
+        continue;
+      if (!next[lo])
+      {
+        next[lo] = true;
+        ++n;
+      }
+      if (!next[hi + 1])
+      {
+        next[hi + 1] = true;
+        ++n;
+      }
     }
-    // add dead state only when needed
-    if (hi <= 0xFF)
+    if (static_cast<size_t>(nds_ + 1) * n > DENSE_DFA_MAX)
+      continue;
+    std::memcpy(bound, next, sizeof(bound));
+    ncl = n;
+    state->dense = nds_++;
+  }
+  if (nds_ == 0)
+    return;
+  ncl_ = 0;
+  for (Char c = 0; c < 256; ++c)
+  {
+    if (bound[c] && c > 0)
+      ++ncl_;
+    cls_[c] = static_cast<uint8_t>(ncl_);
+  }
+  ++ncl_;
+  DBGLOG("END select_dense()");
+}
+
+void Pattern::encode_dense(const State& start)
+{
+  if (nds_ == 0)
+    return;
+  Index *table = new Index[static_cast<size_t>(nds_) * ncl_];
+  for (const State *state = &start; state; state = state->next)
+  {
+    if (state->dense == IMAX)
+      continue;
+    Index *row = table + static_cast<size_t>(state->dense) * ncl_;
+    for (Index k = 0; k < ncl_; ++k)
+      row[k] = IMAX;
+    // the matcher takes the first GOTO opcode that matches, later edges in the loop below overwrite earlier edges
+#if WITH_COMPACT_DFA == -1
+    for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
     {
-      state->edges[hi] = std::pair<Char,State*>(0xFF, NULL);
-      ++nop_;
-    }
+      Char lo = i->first;
+      Char hi = i->second.first;
 #else
-    Char lo = 0xFF;
-    bool covered = false;
     for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
     {
+      Char lo = i->second.first;
       Char hi = i->first;
-      if (lo == hi)
-      {
-        if (i->second.first == 0x00)
-          covered = true;
-        else
-          lo =  i->second.first - 1;
-      }
-      ++nop_;
+#endif
       if (is_meta(lo))
-        nop_ += hi - i->second.first;
+        continue;
+      Index target_index = IMAX;
+      if (i->second.second)
+        target_index = i->second.second->index;
+      for (Char c = lo; c <= hi; ++c)
+        row[cls_[c]] = target_index;
     }
-    // add dead state only when needed
-    if (!covered)
+  }
+  dns_ = table;
+}
+
+Pattern::Opcode *Pattern::encode_dfa(
+    State& start,
+    Index& nop)
+{
+  size_t n = 0;
+  for (State *state = &start; state; state = state->next)
+  {
+    state->index = static_cast<Index>(n);
+    n += encode_size(state);
+    if (n > LMAX)
+      return NULL;
+  }
+  if (n > LONG)
+  {
+    // wide format: a GOTO opcode to a state at index LONG or beyond is followed by a word with the long index,
+    // repeat until the state indices are stable, skipping the indices LONG and IMAX that mark GOTO opcodes
+    bool changed = true;
+    while (changed)
     {
-      state->edges[lo] = std::pair<Char,State*>(0x00, NULL);
-      ++nop_;
-    }
+      changed = false;
+      n = 0;
+      for (State *state = &start; state; state = state->next)
+      {
+        if (n == LONG || n == IMAX)
+          n = IMAX + 1;
+        if (state->index != n)
+        {
+          state->index = static_cast<Index>(n);
+          changed = true;
+        }
+        n += state->heads.size() + state->tails.size() + (state->accept > 0 || state->redo) + (state->dense != IMAX);
+        for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+        {
+#if WITH_COMPACT_DFA == -1
+          Char lo = i->first;
+          Char hi = i->second.first;
+#else
+          Char lo = i->second.first;
+          Char hi = i->first;
 #endif
-    nop_ += static_cast<Index>(state->heads.size() + state->tails.size() + (state->accept > 0 || state->redo));
-    if (nop_ < state->index)
-      throw regex_error(regex_error::exceeds_limits, rex_.c_str());
+          size_t k = is_meta(lo) ? hi - lo + 1 : 1;
+          if (i->second.second && i->second.second->index >= LONG)
+            k *= 2;
+          n += k;
+        }
+        if (n > LMAX)
+          return NULL;
+      }
+    }
   }
-  Opcode *opcode = new Opcode[nop_];
-  opc_ = opcode;
+  nop = static_cast<Index>(n);
+  Opcode *opcode = new Opcode[nop];
   Index pc = 0;
   for (const State *state = &start; state; state = state->next)
   {
-    if (state->redo)
-      opcode[pc++] = opcode_redo();
-    else if (state->accept > 0)
-      opcode[pc++] = opcode_take(state->accept);
-    for (Set::const_iterator i = state->tails.begin(); i != state->tails.end(); ++i)
-      opcode[pc++] = opcode_tail(static_cast<Index>(*i));
-    for (Set::const_iterator i = state->heads.begin(); i != state->heads.end(); ++i)
-      opcode[pc++] = opcode_head(static_cast<Index>(*i));
-#if WITH_COMPACT_DFA == -1
-    for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+    while (pc < state->index)
+      opcode[pc++] = opcode_halt();
+    pc = encode_state(state, opcode, pc);
+  }
+  return opcode;
+}
+
+size_t Pattern::encode_size(State *state) const
+{
+  size_t n = 0;
+#if WITH_COMPACT_DFA == -1
+  Char hi = 0x00;
+  for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+  {
+    Char lo = i->first;
+    if (lo == hi)
+      hi = i->second.first + 1;
+    ++n;
+    if (is_meta(lo))
+      n += i->second.first - lo;
+  }
+  // add dead state only when needed
+  if (hi <= 0xFF)
+  {
+    state->edges[hi] = std::pair<Char,State*>(0xFF, NULL);
+    ++n;
+  }
+#else
+  Char lo = 0xFF;
+  bool covered = false;
+  for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+  {
+    Char hi = i->first;
+    if (lo == hi)
+    {
+      if (i->second.first == 0x00)
+        covered = true;
+      else
+        lo =  i->second.first - 1;
+    }
+    ++n;
+    if (is_meta(lo))
+      n += hi - i->second.first;
+  }
+  // add dead state only when needed
+  if (!covered)
+  {
+    state->edges[lo] = std::pair<Char,State*>(0x00, NULL);
+    ++n;
+  }
+#endif
+  n += state->heads.size() + state->tails.size() + (state->accept > 0 || state->redo) + (state->dense != IMAX);
+  return n;
+}
+
+Pattern::Index Pattern::encode_state(
+    const State *state,
+    Opcode      *opcode,
+    Index        pc) const
+{
+  if (state->redo)
+    opcode[pc++] = opcode_redo();
+  else if (state->accept > 0)
+    opcode[pc++] = opcode_take(state->accept);
+  for (Set::const_iterator i = state->tails.begin(); i != state->tails.end(); ++i)
+    opcode[pc++] = opcode_tail(static_cast<Index>(*i));
+  for (Set::const_iterator i = state->heads.begin(); i != state->heads.end(); ++i)
+    opcode[pc++] = opcode_head(static_cast<Index>(*i));
+  bool dense = state->dense != IMAX;
+#if WITH_COMPACT_DFA == -1
+  for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+  {
+    Char lo = i->first;
+    Char hi = i->second.first;
+    if (dense && !is_meta(lo))
+    {
+      // the GOTO opcodes on chars are preceded by the row of the state in the dense transition table
+      opcode[pc++] = opcode_dense(state->dense);
+      dense = false;
+    }
+    Index target_index = IMAX;
+    if (i->second.second)
+      target_index = i->second.second->index;
+    bool ext = target_index >= LONG && target_index != IMAX;
+    if (!is_meta(lo))
+    {
+      opcode[pc++] = opcode_goto(lo, hi, ext ? static_cast<Index>(LONG) : target_index);
+      if (ext)
+        opcode[pc++] = opcode_long(target_index);
+    }
+    else
+    {
+      do
+      {
+        opcode[pc++] = opcode_goto(lo, lo, ext ? static_cast<Index>(LONG) : target_index);
+        if (ext)
+          opcode[pc++] = opcode_long(target_index);
+      } while (++lo <= hi);
+    }
+  }
+#else
+  for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+  {
+    Char hi = i->first;
+    Char lo = i->second.first;
+    if (is_meta(lo))
     {
-      Char lo = i->first;
-      Char hi = i->second.first;
       Index target_index = IMAX;
       if (i->second.second)
         target_index = i->second.second->index;
-      if (!is_meta(lo))
-      {
-        opcode[pc++] = opcode_goto(lo, hi, target_index);
-      }
-      else
+      bool ext = target_index >= LONG && target_index != IMAX;
+      do
       {
-        do
-        {
-          opcode[pc++] = opcode_goto(lo, lo, target_index);
-        } while (++lo <= hi);
-      }
+        opcode[pc++] = opcode_goto(lo, lo, ext ? static_cast<Index>(LONG) : target_index);
+        if (ext)
+          opcode[pc++] = opcode_long(target_index);
+      } while (++lo <= hi);
     }
-#else
-    for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+  }
+  if (dense)
+    opcode[pc++] = opcode_dense(state->dense);
+  for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+  {
+    Char lo = i->second.first;
+    if (!is_meta(lo))
     {
       Char hi = i->first;
-      Char lo = i->second.first;
-      if (is_meta(lo))
-      {
-        Index target_index = IMAX;
-        if (i->second.second)
-          target_index = i->second.second->index;
-        do
-        {
-          opcode[pc++] = opcode_goto(lo, lo, target_index);
-        } while (++lo <= hi);
-      }
-    }
-    for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
-    {
-      Char lo = i->second.first;
-      if (!is_meta(lo))
-      {
-        Char hi = i->first;
-        Index target_index = IMAX;
-        if (i->second.second)
-          target_index = i->second.second->index;
-        opcode[pc++] = opcode_goto(lo, hi, target_index);
-      }
+      Index target_index = IMAX;
+      if (i->second.second)
+        target_index = i->second.second->index;
+      bool ext = target_index >= LONG && target_index != IMAX;
+      opcode[pc++] = opcode_goto(lo, hi, ext ? static_cast<Index>(LONG) : target_index);
+      if (ext)
+        opcode[pc++] = opcode_long(target_index);
     }
-#endif
   }
+#endif
+  return pc;
 }
 
 void Pattern::gencode_dfa(const State& start) const
 {
-  if (!opt_.o)
+  if (!opt_.o || opt_.a)
     return;
   for (std::vector<std::string>::const_iterator i = opt_.f.begin(); i != opt_.f.end(); ++i)
   {
@@ -1972,9 +3632,23 @@ void Pattern::gencode_dfa(const State& start) const
         ::fprintf(fd, "#include <reflex/matcher.h>\n\n#ifdef OS_WIN\n#pragma warning(push)\n#pragma warning(disable:4102)\n#endif\n\n");
         write_namespace_open(fd);
         ::fprintf(fd, "void reflex_code_%s(reflex::Matcher& m)\n{\n  int c0 = 0, c1 = c0;\n  m.FSM_INIT(c1);\n", opt_.n.empty() ? "FSM" : opt_.n.c_str());
+        // the exit bytes of the states that loop to themselves on most bytes, to skip their runs
+        Skip skip;
+        for (const State *state = &start; state; state = state->next)
+        {
+          if (skip_dfa(*state, skip))
+          {
+            ::fprintf(fd, "  static const reflex::Pattern::Skip skip_S%u = { 0, %u, { 0x%02X, 0x%02X, 0x%02X, 0x%02X }, {", state->index, skip.len, skip.chr[0], skip.chr[1], skip.chr[2], skip.chr[3]);
+            for (int i = 0; i < 32; ++i)
+              ::fprintf(fd, "%s0x%02X", i > 0 ? ", " : " ", skip.bit[i]);
+            ::fprintf(fd, " } };\n");
+          }
+        }
         for (const State *state = &start; state; state = state->next)
         {
           ::fprintf(fd, "\nS%u:\n", state->index);
+          if (skip_dfa(*state, skip))
+            ::fprintf(fd, "  c1 = m.FSM_SKIP(c1, skip_S%u);\n", state->index);
           if (state->redo)
             ::fprintf(fd, "  m.FSM_REDO();\n");
           else if (state->accept > 0)
@@ -2161,90 +3835,919 @@ void Pattern::gencode_dfa(const State& start) const
                 ::fprintf(fd, " goto S%u;\n", target_index);
             }
           }
-#endif
-          ::fprintf(fd, "  return m.FSM_HALT(c1);\n");
+#endif
+          ::fprintf(fd, "  return m.FSM_HALT(c1);\n");
+        }
+        ::fprintf(fd, "}\n\n");
+        write_namespace_close(fd);
+        ::fprintf(fd, "#ifdef OS_WIN\n#pragma warning(pop)\n#endif\n");
+        if (fd != stdout)
+          ::fclose(fd);
+      }
+    }
+  }
+}
+
+void Pattern::gencode_dfa_closure(FILE *fd, const State *state, int nest) const
+{
+  bool elif = false;
+  if (state->redo)
+    ::fprintf(fd, "%*sm.FSM_REDO(c1);\n", 2*nest, "");
+  else if (state->accept > 0)
+    ::fprintf(fd, "%*sm.FSM_TAKE(%u, c1);\n", 2*nest, "", state->accept);
+  for (Set::const_iterator i = state->tails.begin(); i != state->tails.end(); ++i)
+    ::fprintf(fd, "%*sm.FSM_TAIL(%zu);\n", 2*nest, "", *i);
+  if (nest > 5)
+    return;
+  for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+  {
+#if WITH_COMPACT_DFA == -1
+    Char lo = i->first;
+    Char hi = i->second.first;
+#else
+    Char hi = i->first;
+    Char lo = i->second.first;
+#endif
+    if (is_meta(lo))
+    {
+      do
+      {
+        switch (lo)
+        {
+          case META_EOB:
+          case META_EOL:
+            ::fprintf(fd, "%*s", 2*nest, "");
+            if (elif)
+              ::fprintf(fd, "else ");
+            ::fprintf(fd, "if (m.FSM_META_%s(c1)) {\n", meta_label[lo - META_MIN]);
+            gencode_dfa_closure(fd, i->second.second, nest + 1);
+            ::fprintf(fd, "%*s}\n", 2*nest, "");
+            elif = true;
+            break;
+          case META_EWE:
+          case META_BWE:
+          case META_NWE:
+            ::fprintf(fd, "%*s", 2*nest, "");
+            if (elif)
+              ::fprintf(fd, "else ");
+            ::fprintf(fd, "if (m.FSM_META_%s(c0, c1)) {\n", meta_label[lo - META_MIN]);
+            gencode_dfa_closure(fd, i->second.second, nest + 1);
+            ::fprintf(fd, "%*s}\n", 2*nest, "");
+            elif = true;
+            break;
+          default:
+            ::fprintf(fd, "%*s", 2*nest, "");
+            if (elif)
+              ::fprintf(fd, "else ");
+            ::fprintf(fd, "if (m.FSM_META_%s()) {\n", meta_label[lo - META_MIN]);
+            gencode_dfa_closure(fd, i->second.second, nest + 1);
+            ::fprintf(fd, "%*s}\n", 2*nest, "");
+            elif = true;
+        }
+      } while (++lo <= hi);
+    }
+  }
+}
+
+void Pattern::gentable_dfa(const State& start) const
+{
+  if (!opt_.a)
+    return;
+  // number the states in chain order and collect the byte classes from the boundaries of the edges
+  std::map<const State*,Index> id;
+  bool bound[257];
+  std::memset(bound, 0, sizeof(bound));
+  bound[0] = true;
+  bound[256] = true;
+  bool pure = true;
+  for (const State *state = &start; state; state = state->next)
+  {
+    Index n = static_cast<Index>(id.size());
+    id[state] = n;
+    if (state->redo || !state->heads.empty() || !state->tails.empty())
+      pure = false;
+    for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+    {
+#if WITH_COMPACT_DFA == -1
+      Char lo = i->first;
+      Char hi = i->second.first;
+#else
+      Char lo = i->second.first;
+      Char hi = i->first;
+#endif
+      if (is_meta(lo))
+      {
+        pure = false;
+        continue;
+      }
+      bound[lo] = true;
+      bound[hi + 1] = true;
+    }
+  }
+  uint8_t cls[256];
+  Index ncl = 0;
+  for (Char c = 0; c < 256; ++c)
+  {
+    if (bound[c] && c > 0)
+      ++ncl;
+    cls[c] = static_cast<uint8_t>(ncl);
+  }
+  ++ncl;
+  Index halt = static_cast<Index>(id.size());
+  const char *state_type = halt < 0xFFFF ? "uint16_t" : "uint32_t";
+  const char *name = opt_.n.empty() ? "FSM" : opt_.n.c_str();
+  for (std::vector<std::string>::const_iterator i = opt_.f.begin(); i != opt_.f.end(); ++i)
+  {
+    const std::string& filename = *i;
+    size_t len = filename.length();
+    if ((len > 2 && filename.compare(len - 2, 2, ".h"  ) == 0)
+     || (len > 4 && filename.compare(len - 4, 4, ".hpp") == 0)
+     || (len > 4 && filename.compare(len - 4, 4, ".cpp") == 0)
+     || (len > 3 && filename.compare(len - 3, 3, ".cc" ) == 0))
+    {
+      FILE *fd = NULL;
+      int err = 0;
+      if (filename.compare(0, 7, "stdout.") == 0)
+        fd = stdout;
+      else if (filename.at(0) == '+')
+        err = reflex::fopen_s(&fd, filename.c_str() + 1, "a");
+      else
+        err = reflex::fopen_s(&fd, filename.c_str(), "w");
+      if (!err && fd)
+      {
+        ::fprintf(fd, "#include <reflex/tablematcher.h>\n\n");
+        if (!pure)
+          ::fprintf(fd, "#error \"reflex_table_%s: DFA tables do not support anchors, word boundaries, lookaheads, indents and negative patterns\"\n\n", name);
+        write_namespace_open(fd);
+        // a class template with static constexpr members is safe to define in a header included in multiple translation units
+        ::fprintf(fd, "template<typename T = void>\nstruct reflex_table_%s_ {\n  typedef %s state_type;\n  static constexpr state_type start = 0;\n  static constexpr state_type halt = %u;\n  static constexpr unsigned classes = %u;\n", name, state_type, halt, ncl);
+        ::fprintf(fd, "  alignas(64) static constexpr uint8_t cls[256] = {");
+        for (Char c = 0; c < 256; ++c)
+          ::fprintf(fd, "%s%u,", c % 16 ? " " : "\n    ", cls[c]);
+        ::fprintf(fd, "\n  };\n  alignas(64) static constexpr state_type next[%u][%u] = {\n", halt, ncl);
+        std::vector<Index> row(ncl);
+        bool first[256];
+        for (const State *state = &start; state; state = state->next)
+        {
+          row.assign(ncl, halt);
+          // later edges overwrite earlier edges in the loop below, as in encode_dense()
+#if WITH_COMPACT_DFA == -1
+          for (State::Edges::const_iterator i = state->edges.begin(); i != state->edges.end(); ++i)
+          {
+            Char lo = i->first;
+            Char hi = i->second.first;
+#else
+          for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+          {
+            Char lo = i->second.first;
+            Char hi = i->first;
+#endif
+            if (is_meta(lo))
+              continue;
+            Index target = halt;
+            if (i->second.second)
+              target = id[i->second.second];
+            for (Char c = lo; c <= hi; ++c)
+              row[cls[c]] = target;
+          }
+          // the bytes that may begin a match, all bytes when the start state accepts
+          if (state == &start)
+            for (Char c = 0; c < 256; ++c)
+              first[c] = start.accept > 0 || row[cls[c]] != halt;
+          ::fprintf(fd, "    {");
+          for (Index k = 0; k < ncl; ++k)
+            ::fprintf(fd, "%s%u%s", k > 0 && k % 16 == 0 ? "\n     " : " ", row[k], k + 1 < ncl ? "," : " ");
+          ::fprintf(fd, "}, // S%u\n", id[state]);
+        }
+        ::fprintf(fd, "  };\n  alignas(64) static constexpr uint16_t take[%u] = {", halt);
+        Index k = 0;
+        for (const State *state = &start; state; state = state->next, ++k)
+          ::fprintf(fd, "%s%u,", k % 16 ? " " : "\n    ", state->accept);
+        ::fprintf(fd, "\n  };\n  alignas(64) static constexpr bool first[256] = {");
+        for (Char c = 0; c < 256; ++c)
+          ::fprintf(fd, "%s%u,", c % 32 ? " " : "\n    ", first[c]);
+        ::fprintf(fd, "\n  };\n};\n\n");
+        ::fprintf(fd, "template<typename T> constexpr uint8_t reflex_table_%s_<T>::cls[256];\n", name);
+        ::fprintf(fd, "template<typename T> constexpr typename reflex_table_%s_<T>::state_type reflex_table_%s_<T>::next[%u][%u];\n", name, name, halt, ncl);
+        ::fprintf(fd, "template<typename T> constexpr uint16_t reflex_table_%s_<T>::take[%u];\n", name, halt);
+        ::fprintf(fd, "template<typename T> constexpr bool reflex_table_%s_<T>::first[256];\n\n", name);
+        ::fprintf(fd, "typedef reflex_table_%s_<> reflex_table_%s;\n\n", name, name);
+        write_namespace_close(fd);
+        if (fd != stdout)
+          ::fclose(fd);
+      }
+    }
+  }
+}
+
+void Pattern::delete_dfa(State& start)
+{
+  // states allocated in an arena are released with the arena
+  if (start.next != NULL && State::owner(start.next) != NULL)
+  {
+    start.next = NULL;
+    return;
+  }
+  const State *state = start.next;
+  while (state)
+  {
+    const State *next_state = state->next;
+    delete state;
+    state = next_state;
+  }
+  start.next = NULL;
+}
+
+void Pattern::predict_match_dfa()
+{
+  pre_.clear();
+  fno_ = 0;
+  if (!opc_)
+    return;
+  DBGLOG("BEGIN predict_match_dfa()");
+  Index state = 0;
+  bool first = true;
+  while (pre_.size() < 255)
+  {
+    // collect the chars that begin a match from this state and the states reached by meta transitions
+    bool chars[256];
+    size_t count = 0;
+    Index next = IMAX;
+    bool single = true;
+    std::memset(chars, 0, sizeof(chars));
+    std::set<Index> visited;
+    std::vector<Index> closure;
+    closure.push_back(state);
+    visited.insert(state);
+    while (!closure.empty())
+    {
+      const Opcode *pc = opc_ + closure.back();
+      closure.pop_back();
+      // the first edge that matches a char is taken, edges that follow may overlap
+      bool seen[256];
+      size_t covered = 0;
+      std::memset(seen, 0, sizeof(seen));
+      while (covered < 256)
+      {
+        Opcode opcode = *pc++;
+        if (is_opcode_dense(opcode))
+          continue;
+        if (is_opcode_redo(opcode) || is_opcode_take(opcode))
+        {
+          // a match may end here, so no more chars are required
+          state = IMAX;
+          break;
+        }
+        if (is_opcode_tail(opcode) || is_opcode_head(opcode))
+          continue;
+        Index index = index_of(opcode);
+        if (is_opcode_long(opcode))
+          index = long_index_of(*pc++);
+        if (is_opcode_meta(opcode))
+        {
+          Char meta = meta_of(opcode);
+          if (meta == META_IND || meta == META_DED || meta == META_UND)
+          {
+            // indent and dedent depend on the input consumed by preceding matches
+            state = IMAX;
+            break;
+          }
+          if (index != IMAX && visited.insert(index).second)
+            closure.push_back(index);
+          continue;
+        }
+        Char lo = lo_of(opcode);
+        Char hi = hi_of(opcode);
+        bool taken = false;
+        for (Char c = lo; c <= hi; ++c)
+        {
+          if (!seen[c])
+          {
+            seen[c] = true;
+            ++covered;
+            if (index != IMAX)
+            {
+              taken = true;
+              if (!chars[c])
+              {
+                chars[c] = true;
+                ++count;
+              }
+            }
+          }
+        }
+        if (!taken)
+          continue;
+        if (next == IMAX)
+          next = index;
+        else if (next != index)
+          single = false;
+      }
+      if (state == IMAX)
+        break;
+    }
+    if (state == IMAX || count == 0)
+      break;
+    if (first && count < 256)
+    {
+      // the chars that may begin a match are useful to search when not all chars can begin a match
+      std::memcpy(fst_, chars, sizeof(fst_));
+      fno_ = count;
+    }
+    first = false;
+    if (count > 1 || !single)
+      break;
+    for (Char c = 0; c < 256; ++c)
+    {
+      if (chars[c])
+      {
+        pre_.push_back(static_cast<char>(c));
+        break;
+      }
+    }
+    state = next;
+  }
+  DBGLOG("END predict_match_dfa(): %zu chars with prefix %s", fno_, pre_.c_str());
+}
+
+const Pattern::Index Pattern::Hop::NONE;
+
+void Pattern::decode_dfa()
+{
+  hop_.clear();
+  jmp_.clear();
+  hds_.clear();
+  skp_.clear();
+  if (!opc_ || lzy_)
+    return;
+  DBGLOG("BEGIN decode_dfa()");
+  // decode the states reachable from the start state, the jumps refer to the index of the next state in the opcode table until all states are decoded
+  std::map<Index,Index> decoded;
+  std::map<Index,Hop> hops;
+  std::vector<Index> todo(1, 0);
+  decoded[0] = 0;
+  while (!todo.empty())
+  {
+    Index index = todo.back();
+    todo.pop_back();
+    const Opcode *pc = opc_ + index;
+    Hop hop;
+    hop.kind = Hop::GOTO;
+    hop.take = 0;
+    hop.pc = index;
+    hop.next = static_cast<Index>(jmp_.size());
+    Index dense = IMAX;
+    bool opcode = false;
+    bool loop[256];
+    std::memset(loop, 0, sizeof(loop));
+    if (is_opcode_redo(*pc) || is_opcode_take(*pc))
+      hop.take = index_of(*pc++);
+    if (is_opcode_halt(*pc))
+    {
+      hop.kind = hop.take > 0 ? Hop::TAKE_HALT : Hop::HALT;
+    }
+    else
+    {
+      // the first edge that matches a char is taken, edges that follow may overlap
+      bool seen[256];
+      size_t covered = 0;
+      std::memset(seen, 0, sizeof(seen));
+      while (covered < 256)
+      {
+        Opcode code = *pc++;
+        if (is_opcode_dense(code))
+        {
+          dense = index_of(code);
+          continue;
+        }
+        if (is_opcode_tail(code) || is_opcode_head(code))
+        {
+          opcode = true;
+          continue;
+        }
+        Index next = index_of(code);
+        if (is_opcode_long(code))
+          next = long_index_of(*pc++);
+        if (next != IMAX && decoded.find(next) == decoded.end())
+        {
+          decoded[next] = 0;
+          todo.push_back(next);
+        }
+        if (is_opcode_meta(code))
+        {
+          opcode = true;
+          continue;
+        }
+        Char lo = lo_of(code);
+        Char hi = hi_of(code);
+        for (Char c = lo; c <= hi; ++c)
+        {
+          if (!seen[c])
+          {
+            seen[c] = true;
+            loop[c] = (next == index);
+            ++covered;
+          }
         }
-        ::fprintf(fd, "}\n\n");
-        write_namespace_close(fd);
-        ::fprintf(fd, "#ifdef OS_WIN\n#pragma warning(pop)\n#endif\n");
-        if (fd != stdout)
-          ::fclose(fd);
+        Jump jump;
+        jump.lo = static_cast<uint8_t>(lo);
+        jump.hi = static_cast<uint8_t>(hi);
+        jump.hop = next != IMAX ? next : Hop::NONE;
+        jmp_.push_back(jump);
+      }
+      Skip skip;
+      if (opcode)
+      {
+        hop.kind = Hop::OPCODE;
+      }
+      else if (skip_loop(loop, skip))
+      {
+        hop.kind = hop.take > 0 ? Hop::TAKE_SKIP : Hop::SKIP;
+        skip.jump = hop.next;
+        hop.next = static_cast<Index>(skp_.size());
+        skp_.push_back(skip);
+      }
+      else if (dense != IMAX && dns_ != NULL)
+      {
+        hop.kind = hop.take > 0 ? Hop::TAKE_DENSE : Hop::DENSE;
+        hop.next = dense;
+      }
+      else if (hop.take > 0)
+      {
+        hop.kind = Hop::TAKE_GOTO;
       }
     }
+    hops[index] = hop;
+  }
+  // number the decoded states by their index in the opcode table, so the matcher finds a state by its index with hop_at()
+  hop_.reserve(hops.size());
+  for (std::map<Index,Hop>::const_iterator i = hops.begin(); i != hops.end(); ++i)
+  {
+    decoded[i->first] = static_cast<Index>(hop_.size());
+    hop_.push_back(i->second);
+  }
+  for (std::vector<Jump>::iterator i = jmp_.begin(); i != jmp_.end(); ++i)
+    if (i->hop != Hop::NONE)
+      i->hop = decoded[i->hop];
+  if (dns_ != NULL)
+  {
+    hds_.resize(static_cast<size_t>(nds_) * ncl_);
+    for (size_t i = 0; i < hds_.size(); ++i)
+    {
+      std::map<Index,Index>::const_iterator next = decoded.find(dns_[i]);
+      hds_[i] = next != decoded.end() ? next->second : Hop::NONE;
+    }
   }
+  DBGLOG("END decode_dfa(): %zu states %zu jumps %zu skips", hop_.size(), jmp_.size(), skp_.size());
 }
 
-void Pattern::gencode_dfa_closure(FILE *fd, const State *state, int nest) const
+bool Pattern::check_opcodes(
+    const Opcode *code,
+    uint64_t      size,
+    uint64_t      rows)
 {
-  bool elif = false;
-  if (state->redo)
-    ::fprintf(fd, "%*sm.FSM_REDO(c1);\n", 2*nest, "");
-  else if (state->accept > 0)
-    ::fprintf(fd, "%*sm.FSM_TAKE(%u, c1);\n", 2*nest, "", state->accept);
-  for (Set::const_iterator i = state->tails.begin(); i != state->tails.end(); ++i)
-    ::fprintf(fd, "%*sm.FSM_TAIL(%zu);\n", 2*nest, "", *i);
-  if (nest > 5)
-    return;
-  for (State::Edges::const_reverse_iterator i = state->edges.rbegin(); i != state->edges.rend(); ++i)
+  // the GOTO opcodes of a table loaded from a file must jump within the table and the DENSE opcodes to a row of the dense transition table
+  for (uint64_t i = 0; i < size; ++i)
+  {
+    Opcode opcode = code[i];
+    if (is_opcode_take(opcode) || is_opcode_tail(opcode) || is_opcode_head(opcode) || is_opcode_halt(opcode))
+      continue;
+    if (is_opcode_dense(opcode))
+    {
+      if (index_of(opcode) >= rows)
+        return false;
+    }
+    else if (is_opcode_long(opcode))
+    {
+      if (++i >= size || long_index_of(code[i]) >= size)
+        return false;
+    }
+    else if (index_of(opcode) != IMAX && index_of(opcode) >= size)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Pattern::skip_loop(const bool *loop, Skip& skip)
+{
+  size_t exits = 0;
+  for (Char c = 0; c < 256; ++c)
+    if (!loop[c])
+      ++exits;
+  // only a state that loops to itself on most bytes is worth skipping, a short run costs more to search than to match
+  if (exits > 128)
+    return false;
+  skip.jump = 0;
+  skip.len = exits <= 4 ? static_cast<Index>(exits) : 0;
+  std::memset(skip.chr, 0, sizeof(skip.chr));
+  std::memset(skip.bit, 0, sizeof(skip.bit));
+  size_t n = 0;
+  for (Char c = 0; c < 256; ++c)
   {
+    if (!loop[c])
+    {
+      skip.bit[c >> 3] |= static_cast<uint8_t>(1 << (c & 7));
+      if (n < 4)
+        skip.chr[n++] = static_cast<uint8_t>(c);
+    }
+  }
+  // repeat the first exit byte in the unused chr[] to compare 2 to 4 exit bytes the same way
+  while (n > 0 && n < 4)
+    skip.chr[n++] = skip.chr[0];
+  return true;
+}
+
+bool Pattern::skip_dfa(const State& state, Skip& skip)
+{
+  if (!state.heads.empty() || !state.tails.empty())
+    return false;
+  // the first edge that matches a char is taken in the order of gencode_dfa(), edges that follow may overlap
+  bool seen[256];
+  bool loop[256];
+  std::memset(seen, 0, sizeof(seen));
+  std::memset(loop, 0, sizeof(loop));
 #if WITH_COMPACT_DFA == -1
+  for (State::Edges::const_reverse_iterator i = state.edges.rbegin(); i != state.edges.rend(); ++i)
+  {
     Char lo = i->first;
     Char hi = i->second.first;
 #else
-    Char hi = i->first;
+  for (State::Edges::const_iterator i = state.edges.begin(); i != state.edges.end(); ++i)
+  {
     Char lo = i->second.first;
+    Char hi = i->first;
 #endif
     if (is_meta(lo))
+      return false;
+    for (Char c = lo; c <= hi; ++c)
     {
-      do
+      if (!seen[c])
       {
-        switch (lo)
+        seen[c] = true;
+        loop[c] = (i->second.second == &state);
+      }
+    }
+  }
+  return skip_loop(loop, skip);
+}
+
+const unsigned char *Pattern::Skip::find(const unsigned char *s, const unsigned char *e) const
+{
+  if (len == 1)
+  {
+    const void *t = std::memchr(s, chr[0], e - s);
+    return t != NULL ? static_cast<const unsigned char*>(t) : e;
+  }
+#if defined(WITH_SSE2)
+  if (len > 1)
+  {
+    __m128i c0 = _mm_set1_epi8(static_cast<char>(chr[0]));
+    __m128i c1 = _mm_set1_epi8(static_cast<char>(chr[1]));
+    __m128i c2 = _mm_set1_epi8(static_cast<char>(chr[2]));
+    __m128i c3 = _mm_set1_epi8(static_cast<char>(chr[3]));
+    while (s + 16 <= e)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+      __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, c0), _mm_cmpeq_epi8(v, c1)), _mm_or_si128(_mm_cmpeq_epi8(v, c2), _mm_cmpeq_epi8(v, c3)));
+      int mask = _mm_movemask_epi8(m);
+      if (mask != 0)
+      {
+        while ((mask & 1) == 0)
         {
-          case META_EOB:
-          case META_EOL:
-            ::fprintf(fd, "%*s", 2*nest, "");
-            if (elif)
-              ::fprintf(fd, "else ");
-            ::fprintf(fd, "if (m.FSM_META_%s(c1)) {\n", meta_label[lo - META_MIN]);
-            gencode_dfa_closure(fd, i->second.second, nest + 1);
-            ::fprintf(fd, "%*s}\n", 2*nest, "");
-            elif = true;
-            break;
-          case META_EWE:
-          case META_BWE:
-          case META_NWE:
-            ::fprintf(fd, "%*s", 2*nest, "");
-            if (elif)
-              ::fprintf(fd, "else ");
-            ::fprintf(fd, "if (m.FSM_META_%s(c0, c1)) {\n", meta_label[lo - META_MIN]);
-            gencode_dfa_closure(fd, i->second.second, nest + 1);
-            ::fprintf(fd, "%*s}\n", 2*nest, "");
-            elif = true;
-            break;
-          default:
-            ::fprintf(fd, "%*s", 2*nest, "");
-            if (elif)
-              ::fprintf(fd, "else ");
-            ::fprintf(fd, "if (m.FSM_META_%s()) {\n", meta_label[lo - META_MIN]);
-            gencode_dfa_closure(fd, i->second.second, nest + 1);
-            ::fprintf(fd, "%*s}\n", 2*nest, "");
-            elif = true;
+          mask >>= 1;
+          ++s;
         }
-      } while (++lo <= hi);
+        return s;
+      }
+      s += 16;
     }
   }
+#endif
+  while (s < e && (bit[*s >> 3] & (1 << (*s & 7))) == 0)
+    ++s;
+  return s;
 }
 
-void Pattern::delete_dfa(State& start)
+void Pattern::predict_needle_dfa()
 {
-  const State *state = start.next;
-  while (state)
+  ndl_.clear();
+  nmn_ = 0;
+  nmx_ = 0;
+  nnl_ = false;
+  if (!opc_)
+    return;
+  DBGLOG("BEGIN predict_needle_dfa()");
+  // decode the DFA opcode table into a graph with edges labelled by a single char, or -1 for multiple chars, or -2 for meta
+  typedef NeedleEdge Edge;
+  std::map<Index,size_t> node;
+  std::vector<Index> code(1, 0);
+  std::vector<std::vector<Edge> > out;
+  std::vector<bool> acc;
+  node[0] = 0;
+  for (size_t n = 0; n < code.size(); ++n)
   {
-    const State *next_state = state->next;
-    delete state;
-    state = next_state;
+    if (n >= NEEDLE_DFA_MAX)
+      return;
+    out.push_back(std::vector<Edge>());
+    acc.push_back(false);
+    std::map<std::pair<Index,bool>,Edge> edges;
+    const Opcode *pc = opc_ + code[n];
+    bool seen[256];
+    size_t covered = 0;
+    std::memset(seen, 0, sizeof(seen));
+    while (covered < 256)
+    {
+      Opcode opcode = *pc++;
+      if (is_opcode_dense(opcode))
+        continue;
+      if (is_opcode_redo(opcode) || is_opcode_tail(opcode) || is_opcode_head(opcode))
+        return; // negative patterns and lookaheads are not supported
+      if (is_opcode_take(opcode))
+      {
+        acc[n] = true;
+        continue;
+      }
+      Index index = index_of(opcode);
+      if (is_opcode_long(opcode))
+        index = long_index_of(*pc++);
+      bool meta = is_opcode_meta(opcode);
+      Char lo = lo_of(opcode);
+      Char hi = hi_of(opcode);
+      int chr = -2;
+      bool nl = false;
+      if (!meta)
+      {
+        size_t count = 0;
+        for (Char c = lo; c <= hi; ++c)
+        {
+          if (!seen[c])
+          {
+            seen[c] = true;
+            ++covered;
+            ++count;
+            chr = static_cast<int>(c);
+            nl |= (c == '\n');
+          }
+        }
+        if (count == 0 || index == IMAX)
+          continue;
+        if (count > 1)
+          chr = -1;
+      }
+      if (index == IMAX)
+        continue;
+      std::pair<std::map<Index,size_t>::iterator,bool> target = node.insert(std::pair<Index,size_t>(index, code.size()));
+      if (target.second)
+        code.push_back(index);
+      std::pair<Index,bool> key(index, meta);
+      std::map<std::pair<Index,bool>,Edge>::iterator edge = edges.find(key);
+      if (edge == edges.end())
+      {
+        Edge e = { target.first->second, chr, nl };
+        edges[key] = e;
+      }
+      else if (!meta)
+      {
+        edge->second.chr = -1;
+        edge->second.nl |= nl;
+      }
+    }
+    for (std::map<std::pair<Index,bool>,Edge>::const_iterator i = edges.begin(); i != edges.end(); ++i)
+      out[n].push_back(i->second);
   }
-  start.next = NULL;
+  size_t nodes = code.size();
+  // useful nodes lead to an accepting node
+  std::vector<std::vector<size_t> > in(nodes);
+  for (size_t n = 0; n < nodes; ++n)
+    for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+      in[e->to].push_back(n);
+  std::vector<bool> useful(acc);
+  std::vector<size_t> work;
+  for (size_t n = 0; n < nodes; ++n)
+    if (acc[n])
+      work.push_back(n);
+  while (!work.empty())
+  {
+    size_t n = work.back();
+    work.pop_back();
+    for (std::vector<size_t>::const_iterator m = in[n].begin(); m != in[n].end(); ++m)
+    {
+      if (!useful[*m])
+      {
+        useful[*m] = true;
+        work.push_back(*m);
+      }
+    }
+  }
+  if (!useful[0] || acc[0])
+    return;
+  // breadth-first distances from the start node to order the nodes that dominate all accepting nodes
+  std::vector<size_t> dist(nodes, std::string::npos);
+  work.push_back(0);
+  dist[0] = 0;
+  for (size_t i = 0; i < work.size(); ++i)
+  {
+    size_t n = work[i];
+    for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+    {
+      if (useful[e->to] && dist[e->to] == std::string::npos)
+      {
+        dist[e->to] = dist[n] + 1;
+        work.push_back(e->to);
+      }
+    }
+  }
+  std::vector<std::pair<size_t,size_t> > chain;
+  chain.push_back(std::pair<size_t,size_t>(0, 0));
+  for (size_t d = 1; d < nodes; ++d)
+  {
+    if (!useful[d] || dist[d] == std::string::npos)
+      continue;
+    // d dominates all accepting nodes when no accepting node can be reached without passing through d
+    std::vector<bool> visited(nodes, false);
+    work.assign(1, 0);
+    visited[0] = true;
+    bool dominates = true;
+    for (size_t i = 0; i < work.size() && dominates; ++i)
+    {
+      size_t n = work[i];
+      if (acc[n])
+        dominates = false;
+      for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+      {
+        if (e->to != d && useful[e->to] && !visited[e->to])
+        {
+          visited[e->to] = true;
+          work.push_back(e->to);
+        }
+      }
+    }
+    if (dominates)
+      chain.push_back(std::pair<size_t,size_t>(dist[d], d));
+  }
+  std::sort(chain.begin(), chain.end());
+  // the longest run of dominators connected by single char edges is the needle
+  size_t first = 0;
+  size_t needle = 0;
+  std::string run;
+  for (size_t i = 0; i + 1 < chain.size(); ++i)
+  {
+    size_t n = chain[i].second;
+    const Edge *edge = NULL;
+    size_t count = 0;
+    for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+    {
+      if (useful[e->to])
+      {
+        edge = &*e;
+        ++count;
+      }
+    }
+    if (!acc[n] && count == 1 && edge->chr >= 0 && edge->to == chain[i + 1].second)
+    {
+      if (run.empty())
+        first = n;
+      run.push_back(static_cast<char>(edge->chr));
+      if (run.size() > ndl_.size())
+      {
+        ndl_ = run;
+        needle = first;
+      }
+    }
+    else
+    {
+      run.clear();
+    }
+  }
+  if (ndl_.empty())
+  {
+    DBGLOG("END predict_needle_dfa(): no needle");
+    return;
+  }
+  // extend the needle with the char that all edges to the needle have in common, such as @ in [a-z]+@example\.com
+  int chr = -1;
+  if (needle != 0)
+  {
+    for (size_t n = 0; n < nodes && chr != -2; ++n)
+    {
+      if (!useful[n])
+        continue;
+      for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+      {
+        if (e->to == needle)
+        {
+          if (e->chr < 0 || (chr >= 0 && chr != e->chr))
+          {
+            chr = -2;
+            break;
+          }
+          chr = e->chr;
+        }
+      }
+    }
+    if (chr >= 0)
+      ndl_.insert(ndl_.begin(), static_cast<char>(chr));
+  }
+  // the nodes that precede the first node of the needle in a match
+  std::vector<bool> before(nodes, false);
+  if (needle != 0)
+  {
+    work.assign(1, 0);
+    before[0] = true;
+    for (size_t i = 0; i < work.size(); ++i)
+    {
+      size_t n = work[i];
+      for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+      {
+        if (e->to != needle && useful[e->to] && !before[e->to])
+        {
+          before[e->to] = true;
+          work.push_back(e->to);
+        }
+      }
+    }
+  }
+  // min and max number of chars before the needle, and check if newlines may precede the needle
+  std::vector<size_t> lo(nodes, std::string::npos);
+  std::vector<size_t> hi(nodes, 0);
+  std::vector<size_t> deg(nodes, 0);
+  nnl_ = true;
+  for (size_t n = 0; n < nodes; ++n)
+  {
+    if (!before[n])
+      continue;
+    for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+    {
+      if (useful[e->to])
+      {
+        ++deg[e->to];
+        if (e->nl)
+          nnl_ = false;
+      }
+    }
+  }
+  lo[0] = 0;
+  work.assign(1, 0);
+  bool acyclic = deg[0] == 0;
+  size_t sorted = 0;
+  for (size_t i = 0; i < work.size(); ++i)
+  {
+    size_t n = work[i];
+    ++sorted;
+    if (n == needle)
+      continue;
+    for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+    {
+      if (useful[e->to])
+      {
+        size_t w = e->chr != -2;
+        if (lo[n] + w < lo[e->to])
+          lo[e->to] = lo[n] + w;
+        if (hi[n] + w > hi[e->to])
+          hi[e->to] = hi[n] + w;
+        if (--deg[e->to] == 0)
+          work.push_back(e->to);
+      }
+    }
+  }
+  if (acyclic && sorted == static_cast<size_t>(std::count(before.begin(), before.end(), true)) + 1)
+  {
+    nmn_ = lo[needle];
+    nmx_ = hi[needle];
+  }
+  else
+  {
+    // a cycle precedes the needle, so compute the min number of chars only
+    lo.assign(nodes, std::string::npos);
+    lo[0] = 0;
+    work.assign(1, 0);
+    for (size_t i = 0; i < work.size(); ++i)
+    {
+      size_t n = work[i];
+      if (n == needle)
+        continue;
+      for (std::vector<Edge>::const_iterator e = out[n].begin(); e != out[n].end(); ++e)
+      {
+        size_t w = e->chr != -2;
+        if (useful[e->to] && lo[n] + w < lo[e->to])
+        {
+          lo[e->to] = lo[n] + w;
+          work.push_back(e->to);
+        }
+      }
+    }
+    nmn_ = lo[needle];
+    nmx_ = std::string::npos;
+  }
+  if (chr >= 0)
+  {
+    --nmn_;
+    if (nmx_ != std::string::npos)
+      --nmx_;
+  }
+  DBGLOG("END predict_needle_dfa(): needle %s min = %zu max = %zu nl = %d", ndl_.c_str(), nmn_, nmx_, (int)!nnl_);
 }
 
 void Pattern::export_dfa(const State& start) const
@@ -2273,7 +4776,7 @@ void Pattern::export_dfa(const State& start) const
           if (state->redo) // state->accept == IMAX)
             ::fprintf(fd, "\n/*REDO*/\t");
           else if (state->accept)
-            ::fprintf(fd, "\n/*ACCEPT %hu*/\t", state->accept);
+            ::fprintf(fd, "\n/*ACCEPT %u*/\t", state->accept);
           for (Set::const_iterator i = state->heads.begin(); i != state->heads.end(); ++i)
             ::fprintf(fd, "\n/*HEAD %zu*/\t", *i);
           for (Set::const_iterator i = state->tails.begin(); i != state->tails.end(); ++i)
@@ -2290,12 +4793,12 @@ void Pattern::export_dfa(const State& start) const
             ::fprintf(fd, "%s", sep);
             if (i->accept())
             {
-              ::fprintf(fd, "(%hu)", i->accepts());
+              ::fprintf(fd, "(%u)", i->accepts());
             }
             else
             {
               if (i->iter())
-                ::fprintf(fd, "%hu.", i->iter());
+                ::fprintf(fd, "%u.", i->iter());
               ::fprintf(fd, "%zu", i->loc());
             }
             if (i->lazy())
@@ -2315,7 +4818,7 @@ void Pattern::export_dfa(const State& start) const
             ::fprintf(fd, "\\n");
 #endif
           if (state->accept && !state->redo) // state->accept != IMAX)
-            ::fprintf(fd, "[%hu]", state->accept);
+            ::fprintf(fd, "[%u]", state->accept);
           for (Set::const_iterator i = state->tails.begin(); i != state->tails.end(); ++i)
             ::fprintf(fd, "%zu>", *i);
           for (Set::const_iterator i = state->heads.begin(); i != state->heads.end(); ++i)
@@ -2393,7 +4896,7 @@ void Pattern::export_code() const
 {
   if (!nop_)
     return;
-  if (opt_.o)
+  if (opt_.o || opt_.a)
     return;
   for (std::vector<std::string>::const_iterator i = opt_.f.begin(); i != opt_.f.end(); ++i)
   {
@@ -2416,11 +4919,11 @@ void Pattern::export_code() const
       {
         ::fprintf(fd, "#ifndef REFLEX_CODE_DECL\n#include <reflex/pattern.h>\n#define REFLEX_CODE_DECL const reflex::Pattern::Opcode\n#endif\n\n");
         write_namespace_open(fd);
-        ::fprintf(fd, "REFLEX_CODE_DECL reflex_code_%s[%hu] =\n{\n", opt_.n.empty() ? "FSM" : opt_.n.c_str(), nop_);
+        ::fprintf(fd, "REFLEX_CODE_DECL reflex_code_%s[%u] =\n{\n", opt_.n.empty() ? "FSM" : opt_.n.c_str(), nop_);
         for (Index i = 0; i < nop_; ++i)
         {
           Opcode opcode = opc_[i];
-          ::fprintf(fd, "  0x%08X, // %hu: ", opcode, i);
+          ::fprintf(fd, "  0x%08X, // %u: ", opcode, i);
           Index index = index_of(opcode);
           if (is_opcode_redo(opcode))
           {
@@ -2442,12 +4945,16 @@ void Pattern::export_code() const
           {
             ::fprintf(fd, "HALT\n");
           }
+          else if (is_opcode_dense(opcode))
+          {
+            ::fprintf(fd, "DENSE %u\n", index);
+          }
           else
           {
             if (index == IMAX)
               ::fprintf(fd, "HALT ON ");
             else
-              ::fprintf(fd, "GOTO %u ON ", index);
+              ::fprintf(fd, "GOTO %u ON ", index_of(opc_ + i));
             Char lo = lo_of(opcode);
             if (!is_meta(lo))
             {
@@ -2464,6 +4971,11 @@ void Pattern::export_code() const
               ::fprintf(fd, "%s", meta_label[lo - META_MIN]);
             }
             ::fprintf(fd, "\n");
+            if (is_opcode_long(opcode))
+            {
+              ++i;
+              ::fprintf(fd, "  0x%08X, // %u: LONG %u\n", opc_[i], i, long_index_of(opc_[i]));
+            }
           }
         }
         ::fprintf(fd, "};\n\n");
@@ -2506,4 +5018,221 @@ void Pattern::write_namespace_close(FILE* fd) const
 }
 
 
+std::string Pattern::cache_file(const char *opt) const
+{
+  // FNV-1a hash of the file format version, regex and options
+  uint64_t h = 0xCBF29CE484222325ULL;
+  char version[24];
+  (void)::snprintf(version, sizeof(version), "%d", PATTERN_FILE_VERSION);
+  for (const char *s = version; *s != '\0'; ++s)
+    h = (h ^ static_cast<unsigned char>(*s)) * 0x100000001B3ULL;
+  h *= 0x100000001B3ULL;
+  for (std::string::const_iterator i = rex_.begin(); i != rex_.end(); ++i)
+    h = (h ^ static_cast<unsigned char>(*i)) * 0x100000001B3ULL;
+  h *= 0x100000001B3ULL;
+  if (opt != NULL)
+    for (const char *s = opt; *s != '\0'; ++s)
+      h = (h ^ static_cast<unsigned char>(*s)) * 0x100000001B3ULL;
+  char name[24];
+  (void)::snprintf(name, sizeof(name), "%016llx.rfx", static_cast<unsigned long long>(h));
+  std::string file(opt_.c);
+  if (file[file.size() - 1] != '/' && file[file.size() - 1] != '\\')
+    file.push_back('/');
+  return file.append(name);
+}
+
+/// Number of 64 bit words of the header of a compiled pattern file.
+static const size_t FILE_HEAD = 19;
+
+/// Magic number of a compiled pattern file, which also rejects files saved on a machine with a different byte order.
+static const uint64_t FILE_MAGIC = 0x5245666C65785041ULL;
+
+bool Pattern::save(const char *filename) const
+{
+  if (lzy_ != NULL || opc_ == NULL || nop_ == 0)
+    return false;
+  FILE *fd = NULL;
+  if (reflex::fopen_s(&fd, filename, "wb") != 0 || fd == NULL)
+    return false;
+  // header, then the 64 bit subpattern ends, 32 bit opcode tables and dense transition table, and bytes and strings last
+  uint64_t head[FILE_HEAD] = {
+    FILE_MAGIC,
+    PATTERN_FILE_VERSION,
+    rex_.size(),
+    end_.size(),
+    nop_,
+    fop_ != NULL ? nfo_ : 0,
+    rop_ != NULL ? nro_ : 0,
+    dns_ != NULL ? nds_ : 0,
+    dns_ != NULL ? ncl_ : 0,
+    pre_.size(),
+    ndl_.size(),
+    nmn_,
+    nmx_ == std::string::npos ? static_cast<uint64_t>(-1) : nmx_,
+    fno_,
+    nnl_,
+    vno_,
+    uno_,
+    eno_,
+    0
+  };
+  bool ok = ::fwrite(head, sizeof(head), 1, fd) == 1;
+  for (std::vector<Location>::const_iterator i = end_.begin(); ok && i != end_.end(); ++i)
+  {
+    uint64_t loc = *i;
+    ok = ::fwrite(&loc, sizeof(loc), 1, fd) == 1;
+  }
+  ok = ok && ::fwrite(opc_, sizeof(Opcode), nop_, fd) == nop_;
+  ok = ok && (head[5] == 0 || ::fwrite(fop_, sizeof(Opcode), nfo_, fd) == nfo_);
+  ok = ok && (head[6] == 0 || ::fwrite(rop_, sizeof(Opcode), nro_, fd) == nro_);
+  ok = ok && (head[7] == 0 || ::fwrite(dns_, sizeof(Index), static_cast<size_t>(nds_) * ncl_, fd) == static_cast<size_t>(nds_) * ncl_);
+  for (std::vector<bool>::const_iterator i = acc_.begin(); ok && i != acc_.end(); ++i)
+    ok = ::fputc(*i ? 1 : 0, fd) != EOF;
+  ok = ok && ::fwrite(cls_, sizeof(cls_), 1, fd) == 1;
+  ok = ok && ::fwrite(fst_, sizeof(fst_), 1, fd) == 1;
+  ok = ok && ::fwrite(rex_.data(), 1, rex_.size(), fd) == rex_.size();
+  ok = ok && ::fwrite(pre_.data(), 1, pre_.size(), fd) == pre_.size();
+  ok = ok && ::fwrite(ndl_.data(), 1, ndl_.size(), fd) == ndl_.size();
+  ok = ::fclose(fd) == 0 && ok;
+  return ok;
+}
+
+bool Pattern::load(const char *filename)
+{
+  clear();
+  init_options(NULL);
+  if (map(filename, false))
+  {
+    decode_dfa();
+    return true;
+  }
+  clear();
+  return false;
+}
+
+bool Pattern::map(const char *filename, bool cached)
+{
+  DBGLOG("BEGIN map(%s)", filename);
+  const char *mem = NULL;
+  size_t size = 0;
+#if (defined(__WIN32__) || defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(__BORLANDC__)) && !defined(__CYGWIN__) && !defined(__MINGW32__) && !defined(__MINGW64__)
+  // read the file into memory, the tables are used in place
+  FILE *fd = NULL;
+  if (reflex::fopen_s(&fd, filename, "rb") != 0 || fd == NULL)
+    return false;
+  struct _stat st;
+  if (_fstat(_fileno(fd), &st) == 0 && st.st_size >= static_cast<long long>(FILE_HEAD * sizeof(uint64_t)))
+  {
+    size = static_cast<size_t>(st.st_size);
+    char *buf = new char[size];
+    if (::fread(buf, 1, size, fd) == size)
+      mem = buf;
+    else
+      delete[] buf;
+  }
+  ::fclose(fd);
+#else
+  int fd = ::open(filename, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (::fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(FILE_HEAD * sizeof(uint64_t)))
+  {
+    size = static_cast<size_t>(st.st_size);
+    void *addr = ::mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED)
+      mem = static_cast<const char*>(addr);
+  }
+  ::close(fd);
+#endif
+  if (mem == NULL)
+    return false;
+  mem_ = mem;
+  nme_ = size;
+  const uint64_t *head = reinterpret_cast<const uint64_t*>(mem);
+  // check the header and the file size before using the tables in place
+  size_t need = FILE_HEAD * sizeof(uint64_t);
+  if (head[0] == FILE_MAGIC && head[1] == PATTERN_FILE_VERSION && head[4] > 0 && head[4] <= LMAX && head[5] <= LMAX && head[6] <= LMAX && head[7] < LONG && head[8] <= 256 && (head[7] == 0) == (head[8] == 0) && head[2] <= size && head[3] <= size && head[9] <= size && head[10] <= size)
+  {
+    need += head[3] * sizeof(uint64_t) + (head[4] + head[5] + head[6] + head[7] * head[8]) * sizeof(Opcode) + head[3] + sizeof(cls_) + sizeof(fst_) + head[2] + head[9] + head[10];
+    if (need == size)
+    {
+      const char *ptr = mem + FILE_HEAD * sizeof(uint64_t);
+      const uint64_t *end = reinterpret_cast<const uint64_t*>(ptr);
+      ptr += head[3] * sizeof(uint64_t);
+      const Opcode *opc = reinterpret_cast<const Opcode*>(ptr);
+      ptr += head[4] * sizeof(Opcode);
+      const Opcode *fop = reinterpret_cast<const Opcode*>(ptr);
+      ptr += head[5] * sizeof(Opcode);
+      const Opcode *rop = reinterpret_cast<const Opcode*>(ptr);
+      ptr += head[6] * sizeof(Opcode);
+      const Index *dns = reinterpret_cast<const Index*>(ptr);
+      ptr += head[7] * head[8] * sizeof(Index);
+      const char *acc = ptr;
+      ptr += head[3];
+      const char *cls = ptr;
+      ptr += sizeof(cls_);
+      const char *fst = ptr;
+      ptr += sizeof(fst_);
+      std::string rex(ptr, head[2]);
+      ptr += head[2];
+      // check that the tables index within their bounds before the matchers use them unchecked
+      bool valid = check_opcodes(opc, head[4], head[7]) && check_opcodes(fop, head[5], head[7]) && check_opcodes(rop, head[6], head[7]);
+      for (uint64_t i = 0; valid && i < head[7] * head[8]; ++i)
+        valid = dns[i] < head[4] || dns[i] == IMAX;
+      for (size_t i = 0; valid && head[7] > 0 && i < sizeof(cls_); ++i)
+        valid = static_cast<uint8_t>(cls[i]) < head[8];
+      if (valid && (!cached || rex == rex_))
+      {
+        rex_.swap(rex);
+        end_.assign(end, end + head[3]);
+        acc_.resize(head[3]);
+        for (size_t i = 0; i < head[3]; ++i)
+          acc_[i] = acc[i] != 0;
+        opc_ = opc;
+        nop_ = static_cast<Index>(head[4]);
+        fop_ = head[5] > 0 ? fop : NULL;
+        nfo_ = static_cast<Index>(head[5]);
+        rop_ = head[6] > 0 ? rop : NULL;
+        nro_ = static_cast<Index>(head[6]);
+        dns_ = head[7] > 0 ? dns : NULL;
+        nds_ = static_cast<Index>(head[7]);
+        ncl_ = static_cast<Index>(head[8]);
+        std::memcpy(cls_, cls, sizeof(cls_));
+        std::memcpy(fst_, fst, sizeof(fst_));
+        pre_.assign(ptr, head[9]);
+        ptr += head[9];
+        ndl_.assign(ptr, head[10]);
+        nmn_ = static_cast<size_t>(head[11]);
+        nmx_ = head[12] == static_cast<uint64_t>(-1) ? std::string::npos : static_cast<size_t>(head[12]);
+        fno_ = static_cast<size_t>(head[13]);
+        nnl_ = head[14] != 0;
+        vno_ = static_cast<size_t>(head[15]);
+        uno_ = static_cast<size_t>(head[16]);
+        eno_ = static_cast<size_t>(head[17]);
+        pms_ = 0.0;
+        vms_ = 0.0;
+        ems_ = 0.0;
+        wms_ = 0.0;
+        DBGLOG("END map()");
+        return true;
+      }
+    }
+  }
+  unmap();
+  DBGLOG("END map()");
+  return false;
+}
+
+void Pattern::unmap()
+{
+#if (defined(__WIN32__) || defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(__BORLANDC__)) && !defined(__CYGWIN__) && !defined(__MINGW32__) && !defined(__MINGW64__)
+  delete[] mem_;
+#else
+  ::munmap(const_cast<char*>(mem_), nme_);
+#endif
+  mem_ = NULL;
+  nme_ = 0;
+}
+
 } // namespace reflex
@@ -35,6 +35,9 @@
 */
 
 #include <reflex/utf8.h>
+#include <algorithm>
+#include <map>
+#include <vector>
 
 namespace reflex {
 
@@ -276,4 +279,197 @@ std::string utf8(int a, int b, int esc, const char *par, bool strict)
   return regex;
 }
 
+/// Byte automaton of a set of UCS ranges encoded in strict UTF-8, with a state per set of code points in a block that the continuation bytes left match, shared by all sequences that continue alike.
+class UTF8Automaton {
+ public:
+  typedef std::vector< std::pair<int,int> > Set;
+  UTF8Automaton(
+      int         esc,
+      const char *par)
+    :
+      esc_(esc),
+      par_(par),
+      ids_(6),
+      edges_(1)
+  { }
+  /// Returns the start state of a sorted set of UCS ranges [lo,hi].
+  size_t start(const Set& set);
+  /// Returns the regex of a state, the alternation of the byte ranges to each target state followed by the regex of the target state.
+  const std::string& regex(size_t state);
+ private:
+  struct Edge {
+    Edge(int lo, int hi, size_t to) : lo(lo), hi(hi), to(to) { }
+    int    lo; ///< lower bound of the byte range
+    int    hi; ///< upper bound of the byte range
+    size_t to; ///< target state
+  };
+  typedef std::vector<Edge> Edges;
+  size_t state(
+      int        k,
+      const Set& set);
+  void split(
+      Edges&     edges,
+      int        byte,
+      int        k,
+      const Set& set,
+      int        min,
+      int        max);
+  void add(
+      Edges& edges,
+      int    lo,
+      int    hi,
+      size_t to);
+  int                                 esc_;   ///< escape char 'x' for hex \xXX, or '0' or '\0' for octal \0nnn and \nnn
+  const char                         *par_;   ///< capturing or non-capturing parenthesis "(?:"
+  std::vector< std::map<Set,size_t> > ids_;   ///< states of the k continuation bytes left and the set of offsets into the block of 64^k code points
+  std::vector<Edges>                  edges_; ///< edges of the states, state 0 is final
+  std::vector<std::string>            regex_; ///< regex of the states
+  std::vector<size_t>                 alts_;  ///< number of alternatives of the regex of the states, 0 when not computed yet
+};
+
+size_t UTF8Automaton::start(const Set& set)
+{
+  static const int min_ucs[6] = { 0x00, 0x80, 0x800, 0x10000, 0x200000, 0x4000000 };
+  static const int max_ucs[6] = { 0x7F, 0x7FF, 0xFFFF, 0x1FFFFF, 0x3FFFFFF, 0x7FFFFFFF };
+  static const int lead_utf8[6] = { 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
+  Edges edges;
+  // the lead byte of n+1 bytes adds the bits of the code points above the n continuation bytes
+  for (int n = 0; n < 6; ++n)
+    split(edges, lead_utf8[n], n, set, min_ucs[n], max_ucs[n]);
+  edges_.push_back(edges);
+  return edges_.size() - 1;
+}
+
+size_t UTF8Automaton::state(
+    int        k,
+    const Set& set)
+{
+  if (k == 0)
+    return 0;
+  std::map<Set,size_t>::const_iterator i = ids_[k].find(set);
+  if (i != ids_[k].end())
+    return i->second;
+  Edges edges;
+  // a continuation byte adds the next 6 bits of the code points
+  split(edges, 0x80, k - 1, set, 0, 0x7FFFFFFF);
+  edges_.push_back(edges);
+  return ids_[k][set] = edges_.size() - 1;
+}
+
+void UTF8Automaton::split(
+    Edges&     edges,
+    int        byte,
+    int        k,
+    const Set& set,
+    int        min,
+    int        max)
+{
+  int shift = 6 * k;
+  int block = -1;
+  Set offsets;
+  for (Set::const_iterator i = set.begin(); i != set.end(); ++i)
+  {
+    int lo = i->first < min ? min : i->first;
+    int hi = i->second > max ? max : i->second;
+    if (k == 0)
+    {
+      // the last byte of the sequences goes to the final state
+      if (lo <= hi)
+        add(edges, byte + lo, byte + hi, 0);
+      continue;
+    }
+    while (lo <= hi)
+    {
+      // split the range [lo,hi] into blocks of 64^k code points with a byte each
+      int b = lo >> shift;
+      int base = b << shift;
+      int end = (hi >> shift) == b ? hi : base + ((1 << shift) - 1);
+      if (b != block)
+      {
+        if (block >= 0)
+          add(edges, byte + block, byte + block, state(k, offsets));
+        block = b;
+        offsets.clear();
+      }
+      offsets.push_back(std::pair<int,int>(lo - base, end - base));
+      if (end == hi)
+        break;
+      lo = end + 1;
+    }
+  }
+  if (block >= 0)
+    add(edges, byte + block, byte + block, state(k, offsets));
+}
+
+void UTF8Automaton::add(
+    Edges& edges,
+    int    lo,
+    int    hi,
+    size_t to)
+{
+  if (!edges.empty() && edges.back().hi + 1 == lo && edges.back().to == to)
+    edges.back().hi = hi;
+  else
+    edges.push_back(Edge(lo, hi, to));
+}
+
+const std::string& UTF8Automaton::regex(size_t state)
+{
+  if (regex_.size() < edges_.size())
+  {
+    regex_.resize(edges_.size());
+    alts_.resize(edges_.size(), 0);
+  }
+  const Edges& edges = edges_[state];
+  if (alts_[state] > 0 || edges.empty())
+    return regex_[state];
+  // group the byte ranges by target state, in the order of their lowest byte
+  std::vector<size_t> targets;
+  for (Edges::const_iterator i = edges.begin(); i != edges.end(); ++i)
+    if (std::find(targets.begin(), targets.end(), i->to) == targets.end())
+      targets.push_back(i->to);
+  std::string& regex = regex_[state];
+  char buf[16];
+  for (std::vector<size_t>::const_iterator t = targets.begin(); t != targets.end(); ++t)
+  {
+    if (t != targets.begin())
+      regex.push_back('|');
+    const Edge *edge = NULL;
+    size_t count = 0;
+    std::string list;
+    for (Edges::const_iterator i = edges.begin(); i != edges.end(); ++i)
+    {
+      if (i->to == *t)
+      {
+        list.append(regex_range(buf, i->lo, i->hi, esc_, false));
+        edge = &*i;
+        ++count;
+      }
+    }
+    if (count == 1)
+      regex.append(regex_range(buf, edge->lo, edge->hi, esc_));
+    else
+      regex.append("[").append(list).append("]");
+    const std::string& next = this->regex(*t);
+    if (alts_[*t] > 1)
+      regex.append(par_).append(next).push_back(')');
+    else
+      regex.append(next);
+  }
+  alts_[state] = targets.size();
+  return regex;
+}
+
+std::string utf8(
+    const ORanges<int>& ranges,
+    int                 esc,
+    const char         *par)
+{
+  UTF8Automaton::Set set;
+  for (ORanges<int>::const_iterator i = ranges.begin(); i != ranges.end(); ++i)
+    set.push_back(std::pair<int,int>(i->first, i->second - 1));
+  UTF8Automaton automaton(esc, par);
+  return automaton.regex(automaton.start(set));
+}
+
 } // namespace reflex
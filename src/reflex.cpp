@@ -112,6 +112,7 @@ static const char *options_table[] = {
   "stack",
   "stdinit",
   "stdout",
+  "tables",
   "tables_file",
   "tabs",
   "token_type",
@@ -507,6 +508,8 @@ void Reflex::help(const char *message, const char *arg)
                 ignore case in patterns\n\
         -I, --interactive, --always-interactive\n\
                 generate interactive scanner\n\
+        --tables\n\
+                generate scanner with constexpr DFA tables for reflex::TableMatcher\n\
         -m, --matcher=NAME\n\
                 use matcher NAME library [";
   for (LibraryMap::const_iterator i = libraries.begin(); i != libraries.end(); ++i)
@@ -535,7 +538,8 @@ void Reflex::help(const char *message, const char *arg)
         --regexp-file[=FILE]\n\
                 write the scanner's regular expression patterns to FILE.txt\n\
         --tables-file[=FILE]\n\
-                write the scanner's FSM opcode tables or FSM code to FILE.cpp\n\
+                write the scanner's FSM opcode tables or FSM code to FILE.cpp,\n\
+                or the DFA tables of option --tables to FILE.h\n\
 \n\
     Generated code:\n\
         --namespace=NAME\n\
@@ -1569,6 +1573,22 @@ void Reflex::write()
     options["YYSTYPE"] = options["bison_cc_namespace"] + "::" + options["bison_cc_parser"] + "::semantic_type";
   if (!options["bison_complete"].empty() && options["token_type"].empty())
     options["token_type"] = options["bison_cc_namespace"] + "::" + options["bison_cc_parser"] + "::symbol_type";
+  if (!options["tables"].empty())
+  {
+    if (!options["matcher"].empty())
+      abort("option tables requires the reflex matcher");
+    if (conditions.size() > 1)
+      abort("option tables does not support start conditions");
+    // the DFA tables replace the FSM opcode tables and FSM code
+    options["full"].clear();
+    options["fast"].clear();
+    if (options["tables_file"] == "true")
+      options["tables_file"] = std::string("reflex.").append(conditions[0]).append(".h");
+    else if (!options["tables_file"].empty())
+      file_ext(options["tables_file"], "h");
+    if (!options["tables_file"].empty())
+      write_tables_file(options["tables_file"]);
+  }
   std::string token_type = options["token_type"].empty() ? "int" : options["token_type"];
   std::string yyltype = options["YYLTYPE"].empty() ? "YYLTYPE" : options["YYLTYPE"];
   std::string yystype = options["YYSTYPE"].empty() ? "YYSTYPE" : options["YYSTYPE"];
@@ -1593,6 +1613,8 @@ void Reflex::write()
   write_defines();
   write_class();
   write_section_1();
+  if (!options["tables"].empty())
+    write_tables(ofs, options["outfile"]);
   write_lexer();
   write_main();
   write_section_3();
@@ -1750,6 +1772,8 @@ void Reflex::write()
       else
         *out << "YY_EXTERN_C " << token_type << " yylex(void);\n";
     }
+    if (!options["tables"].empty())
+      write_tables(ofs, options["header_file"]);
     *out << std::endl << "#endif" << std::endl;
     if (!out->good())
       abort("error in writing");
@@ -1828,8 +1852,24 @@ void Reflex::write_class()
   if (!out->good())
     return;
   write_banner("REGEX MATCHER");
-  *out << "#include <" << library->file << ">" << std::endl;
-  const char *matcher = library->matcher;
+  std::string matcher = library->matcher;
+  if (!options["tables"].empty())
+  {
+    // declare the DFA tables type for reflex::TableMatcher, the tables are defined in the TABLES section
+    *out << "#include <reflex/tablematcher.h>" << std::endl << std::endl;
+    if (!options["namespace"].empty())
+      write_namespace_open();
+    *out <<
+      "template<typename T> struct reflex_table_" << conditions[0] << "_;\n"
+      "typedef reflex_table_" << conditions[0] << "_<void> reflex_table_" << conditions[0] << ";\n";
+    if (!options["namespace"].empty())
+      write_namespace_close();
+    matcher.assign("reflex::TableMatcher<reflex_table_").append(conditions[0]).append(">");
+  }
+  else
+  {
+    *out << "#include <" << library->file << ">" << std::endl;
+  }
   std::string lex = options["lex"];
   std::string token_type = options["token_type"].empty() ? "int" : options["token_type"];
   std::string yyltype = options["YYLTYPE"].empty() ? "YYLTYPE" : options["YYLTYPE"];
@@ -2447,7 +2487,11 @@ void Reflex::write_lexer()
   {
     if (options["matcher"].empty())
     {
-      if (!options["full"].empty() || !options["fast"].empty())
+      if (!options["tables"].empty())
+      {
+        *out << "  static const reflex_table_" << conditions[start] << " PATTERN_" << conditions[start] << " = reflex_table_" << conditions[start] << "();\n";
+      }
+      else if (!options["full"].empty() || !options["fast"].empty())
       {
         *out << "  static const reflex::Pattern PATTERN_" << conditions[start] << "(reflex_code_" << conditions[start] << ");\n";
       }
@@ -2707,6 +2751,52 @@ void Reflex::write_main()
   }
 }
 
+/// Write the DFA tables for reflex::TableMatcher to lex.yy.cpp, or include the tables file
+void Reflex::write_tables(std::ofstream& ofs, const std::string& filename)
+{
+  if (!out->good())
+    return;
+  // the DFA tables must be defined before the lexer uses reflex::TableMatcher
+  write_banner("TABLES");
+  if (!options["tables_file"].empty())
+  {
+    *out << "#include \"" << options["tables_file"] << "\"" << std::endl;
+  }
+  else if (!ofs.is_open())
+  {
+    out->flush();
+    write_tables_file("stdout.h");
+    fflush(stdout);
+  }
+  else
+  {
+    // the tables are appended to the file by reflex::Pattern
+    ofs.close();
+    write_tables_file(std::string("+").append(filename));
+    ofs.open(filename.c_str(), std::ofstream::out | std::ofstream::app);
+    if (!ofs.is_open())
+      abort("cannot open file ", filename.c_str());
+  }
+}
+
+/// Write the DFA tables for reflex::TableMatcher to the specified file
+void Reflex::write_tables_file(const std::string& filename)
+{
+  std::string option = "r;a";
+  option.append(";n=").append(conditions[0]);
+  if (!options["namespace"].empty())
+    option.append(";z=").append(options["namespace"]);
+  option.append(";f=").append(escape_bs(filename));
+  try
+  {
+    reflex::Pattern pattern(patterns[0], option);
+  }
+  catch (reflex::regex_error& e)
+  {
+    abort("malformed regular expression\n", e.what());
+  }
+}
+
 /// Write regex string to lex.yy.cpp by escaping \ and ", prevent trigraphs, very long strings are represented by character arrays
 void Reflex::write_regex(const std::string *condition, const std::string& regex)
 {
@@ -2839,7 +2929,11 @@ void Reflex::stats()
         option.append(";f=").append(start > 0 ? "+" : "").append(file_ext(options["graphs_file"], "gv"));
       if (!options["fast"].empty())
         option.append(";o");
-      if (options["tables_file"] == "true")
+      if (!options["tables"].empty())
+      {
+        // the DFA tables of option tables are written by write_tables()
+      }
+      else if (options["tables_file"] == "true")
         option.append(";f=reflex.").append(conditions[start]).append(".cpp");
       else if (!options["tables_file"].empty())
         option.append(";f=").append(start > 0 ? "+" : "").append(file_ext(options["tables_file"], "cpp"));
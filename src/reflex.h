@@ -154,6 +154,8 @@ class Reflex
   void        write_code(const Code& code);
   void        write_lexer();
   void        write_main();
+  void        write_tables(std::ofstream& ofs, const std::string& filename);
+  void        write_tables_file(const std::string& filename);
   void        write_regex(const std::string *condition, const std::string& regex);    
   void        write_namespace_open();
   void        write_namespace_close();
@@ -5,6 +5,9 @@
 // c++ -std=gnu++11 -Wall test.cpp pattern.cpp matcher.cpp
 
 #include <reflex/matcher.h>
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
 
 // #define INTERACTIVE // for interactive mode testing
 
@@ -28,6 +31,14 @@ static void error(const char *text)
 
 using namespace reflex;
 
+// find all matches of a pattern in an input, run by two threads that share a lazy DFA
+static void find_all(const Pattern *pattern, const std::string *input, std::string *result)
+{
+  Matcher matcher(*pattern, *input);
+  while (matcher.find())
+    result->append(matcher.text()).append("/");
+}
+
 class WrappedMatcher : public Matcher {
  public:
   WrappedMatcher() : Matcher(), source(0)
@@ -62,6 +73,9 @@ Test tests[] = {
   { "ab", "", "", "abab", { 1, 1 } },
   { "ab|xy", "", "", "abxy", { 1, 2 } },
   { "a(p|q)z", "", "", "apzaqz", { 1, 1 } },
+  // Alternations of strings
+  { "ab|b|abc|bc|ab", "", "", "abcbcbab", { 3, 4, 2, 1 } },
+  { "a\\.b|a\\\\b|\\(a\\)", "", "", "a.ba\\b(a)", { 1, 2, 3 } },
   // DFA edge compaction test
   { "[a-cg-ik]z|d|[e-g]|j|y|[x-z]|.|\\n", "", "", "azz", { 1, 6 } },
   // POSIX character classes
@@ -303,6 +317,10 @@ int main()
   Pattern pattern6("");
   Pattern pattern7("[[:alpha:]]");
   Pattern pattern8("\\w+");
+  Pattern pattern9("bc|abcd|a+y");
+  Pattern pattern10("\\<ab\\w*");
+  Pattern pattern11("[a-z]+@example\\.com");
+  Pattern pattern12("(ab|xb)c+", "d");
 
   Matcher matcher(pattern1);
   std::string test;
@@ -335,6 +353,58 @@ int main()
     error("find with nullable results");
   matcher.reset("");
   //
+  matcher.pattern(pattern9);
+  matcher.input("xabcd abc aaaaz aay");
+  test = "";
+  while (matcher.find())
+  {
+    std::cout << matcher.text() << "/";
+    test.append(matcher.text()).append("/");
+  }
+  std::cout << std::endl;
+  if (test != "abcd/bc/aay/")
+    error("find leftmost longest results");
+  //
+  matcher.pattern(pattern10);
+  matcher.input("cab abc xab ab");
+  test = "";
+  while (matcher.find())
+  {
+    std::cout << matcher.text() << "/";
+    test.append(matcher.text()).append("/");
+  }
+  std::cout << std::endl;
+  if (test != "abc/ab/")
+    error("find with prefix results");
+  //
+  if (pattern11.needle() != "@example.com")
+    error("pattern needle");
+  matcher.pattern(pattern11);
+  matcher.input("x bob@example.com al@example.org\nc@example.com");
+  test = "";
+  while (matcher.find())
+  {
+    std::cout << matcher.text() << "/";
+    test.append(matcher.text()).append("/");
+  }
+  std::cout << std::endl;
+  if (test != "bob@example.com/c@example.com/")
+    error("find with needle results");
+  //
+  if (pattern12.nodes() >= pattern12.nodes_unminimized())
+    error("pattern minimization");
+  matcher.pattern(pattern12);
+  matcher.input("abc xbcc ab xbc");
+  test = "";
+  while (matcher.find())
+  {
+    std::cout << matcher.text() << "/";
+    test.append(matcher.text()).append("/");
+  }
+  std::cout << std::endl;
+  if (test != "abc/xbcc/xbc/")
+    error("find with minimized pattern results");
+  //
   banner("TEST SPLIT");
   //
   matcher.pattern(pattern3);
@@ -623,6 +693,336 @@ int main()
     error("match results");
   std::cout << std::endl;
   //
+  Pattern pattern13("[ab]*a[ab]{14}\\>"); // DFA with 2^15 states exceeds the compact opcode format
+  if (pattern13.words() <= Pattern::IMAX)
+    error("pattern wide opcodes");
+  matcher.pattern(pattern13);
+  matcher.input("baabbbbbbbbbbbbbb");
+  if (matcher.matches())
+    std::cout << "OK";
+  else
+    error("match results");
+  std::cout << std::endl;
+  matcher.input("bbbaabbbbbbbbbbbb");
+  if (!matcher.matches())
+    std::cout << "OK";
+  else
+    error("match results");
+  std::cout << std::endl;
+  //
+  Pattern pattern14("[ab]*a[ab]{14}\\>", "y=4096;"); // lazy DFA flushes its cache of 4096 words
+  std::string input;
+  unsigned int seed = 1;
+  for (int i = 0; i < 20000; ++i)
+  {
+    seed = 1103515245 * seed + 12345;
+    input.push_back("aab"[(seed >> 16) % 3]);
+    if ((seed >> 8) % 23 == 0)
+      input.push_back(' ');
+  }
+  matcher.pattern(pattern13);
+  matcher.input(input);
+  std::string expect;
+  while (matcher.find())
+    expect.append(matcher.text()).append("/");
+  matcher.pattern(pattern14);
+  matcher.input(input);
+  test = "";
+  while (matcher.find())
+    test.append(matcher.text()).append("/");
+  if (test == expect && !test.empty() && pattern14.words() <= 4096)
+    std::cout << "OK";
+  else
+    error("find with lazy DFA results");
+  std::cout << std::endl;
+  //
+  Pattern pattern15("(auto|break|case|char|const|continue|default|do|double|else|enum|extern|float|for|goto|if|int|long|return|while)|([A-Za-z_][A-Za-z0-9_]*)|([0-9]+)|(\\s+)|([-+*/%=<>!&|^~?:;,.(){}\\[\\]])"); // states with many edges use the dense transition table
+  Pattern pattern16(pattern15[0], "y"); // lazy DFA without dense transition table
+  input = "int main(void) { for (int i = 0; i < 10; ++i) if (i % 3 == 0) continue; else break; return do_it(x1[2], _y) ? 0 : 1; }";
+  matcher.pattern(pattern16);
+  matcher.input(input);
+  expect = "";
+  while (matcher.scan())
+    expect.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  matcher.pattern(pattern15);
+  matcher.input(input);
+  test = "";
+  while (matcher.scan())
+    test.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  if (test == expect && matcher.at_end() && test.find("1continue/") != std::string::npos && test.find("2do_it/") != std::string::npos)
+    std::cout << "OK";
+  else
+    error("scan with dense transition table results");
+  std::cout << std::endl;
+  //
+  if (!pattern15.save("rtest.rfx"))
+    error("save compiled pattern");
+  Pattern pattern17;
+  if (!pattern17.load("rtest.rfx") || pattern17[0] != pattern15[0] || pattern17.words() != pattern15.words() || pattern17.size() != pattern15.size())
+    error("load compiled pattern");
+  matcher.pattern(pattern17);
+  matcher.input(input);
+  test = "";
+  while (matcher.scan())
+    test.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  if (test == expect && matcher.at_end())
+    std::cout << "OK";
+  else
+    error("scan with loaded pattern results");
+  {
+    // a file with a GOTO opcode that jumps beyond the opcode table is rejected
+    FILE *fd = fopen("rtest.rfx", "r+b");
+    Pattern::Opcode opcode = 0x00FFFFF0; // GOTO on any char to opcode word 0xFFF0
+    if (fd == NULL || pattern15.words() >= 0xFFF0 || fseek(fd, (19 + pattern15.size()) * 8, SEEK_SET) != 0 || fwrite(&opcode, sizeof(opcode), 1, fd) != 1 || fclose(fd) != 0)
+      error("corrupt compiled pattern");
+    Pattern pattern;
+    if (!pattern.load("rtest.rfx") && pattern.size() == 0)
+      std::cout << "OK";
+    else
+      error("load corrupted compiled pattern");
+  }
+  std::remove("rtest.rfx");
+  std::cout << std::endl;
+  //
+  Pattern pattern18("[ab]*a[ab]{8}|(c+?d)", "t=4;"); // frontiers of more than 64 states are compiled by 4 threads
+  Pattern pattern19(pattern18[0]);
+  input = "abbabaabbabbbabcccdbaabaaab";
+  matcher.pattern(pattern19);
+  matcher.input(input);
+  expect = "";
+  while (matcher.find())
+    expect.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  matcher.pattern(pattern18);
+  matcher.input(input);
+  test = "";
+  while (matcher.find())
+    test.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  if (test == expect && !test.empty() && pattern18.nodes() == pattern19.nodes() && pattern18.words() == pattern19.words() && pattern18.nodes() > 512)
+    std::cout << "OK";
+  else
+    error("subset construction with threads results");
+  std::cout << std::endl;
+  //
+  Pattern pattern20(Matcher::convert("[A-Z\\x{7ff}-\\x{801}\\x{fff0}-\\x{10010}\\x{10fffe}-\\x{10ffff}]", convert_flag::unicode)); // UTF-8 byte ranges that continue alike are merged
+  matcher.pattern(pattern20);
+  const int ucs[] = { 0x40, 0x41, 0x5a, 0x5b, 0x7fe, 0x7ff, 0x800, 0x801, 0x802, 0xffef, 0xfff0, 0xffff, 0x10000, 0x10010, 0x10011, 0x10fffd, 0x10fffe, 0x10ffff };
+  test = "";
+  for (size_t i = 0; i < sizeof(ucs)/sizeof(ucs[0]); ++i)
+  {
+    char buf[8];
+    matcher.input(Input(buf, utf8(ucs[i], buf)));
+    test.push_back(matcher.matches() ? '1' : '0');
+  }
+  if (test == "011001110011110011")
+    std::cout << "OK";
+  else
+    error("UTF-8 match results");
+  std::cout << std::endl;
+  //
+  Pattern pattern21(Matcher::convert("[\\p{L}_][\\p{L}\\p{N}_]*|\\p{N}+", convert_flag::unicode)); // classes used repeatedly are translated once
+  matcher.pattern(pattern21);
+  matcher.input("\xce\xb1\xce\xb2_\xd9\xa3 \xd9\xa3\xce\xb1");
+  test = "";
+  while (matcher.find())
+    test.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  if (test == "1\xce\xb1\xce\xb2_\xd9\xa3/2\xd9\xa3/1\xce\xb1/")
+    std::cout << "OK";
+  else
+    error("UTF-8 match results");
+  std::cout << std::endl;
+  //
+  Pattern pattern22("[a-z]{2,4}|[0-9]{1,1000}"); // bounded repeats end the search DFA at the first accepting state
+  matcher.pattern(pattern22);
+  matcher.input("abcdefg h ij 0123456789x");
+  test = "";
+  while (matcher.find())
+    test.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  if (test == "1abcd/1efg/1ij/20123456789/")
+    std::cout << "OK";
+  else
+    error("find bounded repeats results");
+  std::cout << std::endl;
+  //
+  Pattern pattern23("(a|b)*a(a|b){10}|(c+)", "v=256;"); // DFA of 2048+ states is constructed on demand instead
+  Pattern pattern24("(a|b)*a(a|b){10}|(c+)");
+  input = "abbabaabbabbbabcccbaabaaabbbabbbbbbbbbbbbbbbbabbaabacaaaaaaaaaaaaaaaaaa";
+  matcher.pattern(pattern24);
+  matcher.input(input);
+  expect = "";
+  while (matcher.find())
+    expect.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  matcher.pattern(pattern23);
+  matcher.input(input);
+  test = "";
+  while (matcher.find())
+    test.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  if (test == expect && test.find("2ccc/") != std::string::npos && pattern23.on_demand() && !pattern24.on_demand() && pattern24.nodes() > 2048)
+    std::cout << "OK";
+  else
+    error("DFA constructed on demand beyond the states of option v results");
+  std::cout << std::endl;
+  //
+  Pattern::Budget budget(1000); // at most 1000 states
+  Pattern pattern25;
+  try
+  {
+    pattern25.budget(&budget).assign("(a|b)*a(a|b){10}");
+    error("budget states not exceeded");
+  }
+  catch (const regex_error& e)
+  {
+    if (e.code() != regex_error::exceeds_budget || pattern25.nodes() == 0 || pattern25.nodes() > 1000 || pattern25.edges() == 0)
+      error("budget states exceeded results");
+  }
+  budget.cancel();
+  try
+  {
+    pattern25.assign("abc");
+    error("budget cancellation");
+  }
+  catch (const regex_error& e)
+  {
+    if (e.code() != regex_error::exceeds_budget)
+      error("budget cancelled results");
+  }
+  Pattern::Budget budget2(0, 1 << 16); // at most 64K bytes, including the bytes of the threads of option t
+  try
+  {
+    pattern25.budget(&budget2).assign("(a|b)*a(a|b){12}", "t=4;");
+    error("budget bytes not exceeded");
+  }
+  catch (const regex_error& e)
+  {
+    if (e.code() != regex_error::exceeds_budget || pattern25.nodes() == 0)
+      error("budget bytes exceeded results");
+  }
+  Pattern::Budget budget1(1000, 1 << 20, 1000.0);
+  pattern25.budget(&budget1).assign("(a|b)*a(a|b){5}");
+  matcher.pattern(pattern25);
+  if (matcher.input("abbbbbab").find() && matcher.str() == "abbbbb" && pattern25.nodes() == 64)
+    std::cout << "OK";
+  else
+    error("construction within budget results");
+  std::cout << std::endl;
+  //
+  Pattern pattern26("(\\w+)|(\\s+)|(.)", "a;f=dump.h"); // DFA tables for ttest
+  matcher.pattern(pattern26);
+  if (matcher.input("ab c!").scan() == 1 && matcher.scan() == 2 && matcher.scan() == 1 && matcher.scan() == 3 && matcher.at_end())
+    std::cout << "OK";
+  else
+    error("pattern with DFA tables results");
+  std::cout << std::endl;
+  //
+  Pattern pattern27("([a-z]+)|(\\x00+)|(^\\x00)|(.|\\n)", "m"); // \0 in the input is not the sentinel \0 at the end of the buffered input
+  Pattern pattern28("[a-z]\\x00+");
+  input = std::string("ab\0\0c\n\0d\0", 9);
+  for (size_t blk = 0; blk <= 1; ++blk)
+  {
+    matcher.pattern(pattern27).input(input);
+    if (blk > 0)
+      matcher.buffer(blk); // read the input one byte at a time
+    static const size_t nuls[] = { 1, 2, 2, 2, 1, 1, 4, 1, 3, 1, 1, 1, 2, 1 }; // accept and size of each match
+    size_t k = 0;
+    while (k < 14 && matcher.scan() == nuls[k] && matcher.size() == nuls[k + 1])
+      k += 2;
+    if (k != 14 || matcher.scan() || !matcher.at_end())
+      error("scan input with \\0 results");
+    matcher.pattern(pattern28).input(input);
+    if (blk > 0)
+      matcher.buffer(blk);
+    if (matcher.find() && matcher.first() == 1 && matcher.size() == 3 && matcher.find() && matcher.first() == 7 && matcher.size() == 2 && !matcher.find() && matcher.at_end())
+      std::cout << "OK";
+    else
+      error("find input with \\0 results");
+  }
+  std::cout << std::endl;
+  //
+  Pattern pattern29("(\"[^\"\\n]*\")|(//[^\\n]*)|([ \\t]+)|(\\n)"); // runs of the states that loop to themselves on most bytes are skipped
+  input = "\"" + std::string(10000, 'x') + "\" //" + std::string(10000, '/') + "\n\"\"//\n";
+  matcher.pattern(pattern29);
+  for (size_t blk = 0; blk <= 1; ++blk)
+  {
+    matcher.input(input);
+    if (blk > 0)
+      matcher.buffer(blk); // refill the buffer at every byte of the runs
+    static const size_t runs[] = { 1, 10002, 3, 1, 2, 10002, 4, 1, 1, 2, 2, 2, 4, 1 }; // accept and size of each match
+    size_t k = 0;
+    while (k < 14 && matcher.scan() == runs[k] && matcher.size() == runs[k + 1])
+      k += 2;
+    if (k == 14 && !matcher.scan() && matcher.at_end())
+      std::cout << "OK";
+    else
+      error("skip runs of states results");
+  }
+  std::cout << std::endl;
+  //
+  Pattern pattern30("[ab]*a[ab]{16}"); // more than 65536 decoded DFA states
+  input = "bbabbaabbabaaaaabbbbabbbbbbbbbbbbbbbabbbbbbbbbbbbbbbb";
+  matcher.pattern(pattern30);
+  if (pattern30.nodes() > 65536 && !pattern30.on_demand() && matcher.input(input).matches() && matcher.input(input).find() && matcher.size() == input.size())
+    std::cout << "OK";
+  else
+    error("DFA with more than 65536 states results");
+  std::cout << std::endl;
+  //
+  Pattern pattern31("[ab]*a[ab]{14}\\>", "y=4096;"); // two matchers share a lazy DFA that flushes its cache of 4096 words
+  input = "";
+  seed = 7;
+  for (int i = 0; i < 20000; ++i)
+  {
+    seed = 1103515245 * seed + 12345;
+    input.push_back("aab"[(seed >> 16) % 3]);
+    if ((seed >> 8) % 23 == 0)
+      input.push_back(' ');
+  }
+  std::string input2 = input.substr(1);
+  std::string expect2;
+  expect = "";
+  find_all(&pattern13, &input, &expect);
+  find_all(&pattern13, &input2, &expect2);
+  {
+    // two matchers take turns to find the next match
+    Matcher matcher1(pattern31, input);
+    Matcher matcher2(pattern31, input2);
+    std::string test2;
+    test = "";
+    bool found1 = true;
+    bool found2 = true;
+    while (found1 || found2)
+    {
+      if (found1 && (found1 = matcher1.find()))
+        test.append(matcher1.text()).append("/");
+      if (found2 && (found2 = matcher2.find()))
+        test2.append(matcher2.text()).append("/");
+    }
+    if (test == expect && test2 == expect2 && !test.empty() && test != test2)
+      std::cout << "OK";
+    else
+      error("find with two matchers sharing a lazy DFA results");
+#if __cplusplus >= 201103L
+    // two matchers in two threads
+    test = "";
+    test2 = "";
+    std::thread thread1(find_all, &pattern31, &input, &test);
+    std::thread thread2(find_all, &pattern31, &input2, &test2);
+    thread1.join();
+    thread2.join();
+    if (test == expect && test2 == expect2)
+      std::cout << "OK";
+    else
+      error("find with two threads sharing a lazy DFA results");
+#endif
+  }
+  std::cout << std::endl;
+  //
+  Pattern pattern32("[0-9]+", "a;f=+dump.h;n=DIGITS"); // DFA tables for ttest, only digits may begin a match
+  matcher.pattern(pattern32);
+  if (matcher.input("ab 12").find() && matcher.text() == std::string("12") && pattern32.nodes() == 2)
+    std::cout << "OK";
+  else
+    error("pattern with DFA tables results");
+  std::cout << std::endl;
+  //
   banner("DONE");
   return 0;
 }
@@ -0,0 +1,110 @@
+// DFA tables generated by rtest with reflex::Pattern("(\\w+)|(\\s+)|(.)", "a;f=dump.h") and reflex::Pattern("[0-9]+", "a;f=+dump.h;n=DIGITS"), make -f Make ttest runs rtest first
+#include "dump.h"
+#include <reflex/matcher.h>
+#include <sstream>
+
+static void banner(const char *title)
+{
+  int i;
+  printf("\n\n/");
+  for (i = 0; i < 78; i++)
+    putchar('*');
+  printf("\\\n *%76s*\n * %-75s*\n *%76s*\n\\", "", title, "");
+  for (i = 0; i < 78; i++)
+    putchar('*');
+  printf("/\n\n");
+}
+
+static void error(const char *text)
+{
+  std::cout << "FAILED: " << text << std::endl;
+  exit(EXIT_FAILURE);
+}
+
+using namespace reflex;
+
+typedef TableMatcher<reflex_table_FSM> FSMMatcher;
+
+int main()
+{
+  banner("TABLE MATCHER TESTS");
+  const char *input = "Hello  World, 42 times!\n\tBye.";
+  //
+  Pattern pattern("(\\w+)|(\\s+)|(.)");
+  Matcher matcher(pattern, input);
+  FSMMatcher table(input);
+  std::string expect, test;
+  while (matcher.scan())
+    expect.append(1, static_cast<char>('0' + matcher.accept())).append(matcher.text()).append("/");
+  while (table.scan())
+    test.append(1, static_cast<char>('0' + table.accept())).append(table.text()).append("/");
+  if (test == expect && table.at_end())
+    std::cout << "OK";
+  else
+    error("scan results");
+  std::cout << std::endl;
+  //
+  test.clear();
+  table.input("  ab cd ");
+  while (table.find())
+    test.append(1, static_cast<char>('0' + table.accept())).append(table.text()).append("/");
+  if (test == "2  /1ab/2 /1cd/2 /")
+    std::cout << "OK";
+  else
+    error("find results");
+  std::cout << std::endl;
+  //
+  expect.clear();
+  test.clear();
+  matcher.input("ab!cd");
+  while (matcher.split())
+    expect.append(1, static_cast<char>('0' + matcher.accept() % 64)).append(matcher.text()).append("/");
+  table.input("ab!cd");
+  while (table.split())
+    test.append(1, static_cast<char>('0' + table.accept() % 64)).append(table.text()).append("/");
+  if (test == expect)
+    std::cout << "OK";
+  else
+    error("split results");
+  std::cout << std::endl;
+  //
+  TableMatcher<reflex_table_DIGITS> digits(Input("ab\0" "12\n\0\0cd345\0", 14)); // \0 in the input is not the sentinel \0
+  test.clear();
+  while (digits.find())
+    test.append(digits.text()).append("/");
+  if (test == "12/345/" && digits.at_end())
+    std::cout << "OK";
+  else
+    error("find skipping results");
+  test.clear();
+  digits.input("a1b22c");
+  while (digits.split())
+    test.append(digits.text()).append("/");
+  digits.input("ab\ncd");
+  if (test == "a/b/c/" && !digits.find() && digits.at_end())
+    std::cout << "OK";
+  else
+    error("split skipping results");
+  std::cout << std::endl;
+  //
+  std::istringstream stream("ab cd");
+  test.clear();
+  table.input(stream).interactive();
+  while (table.scan())
+    test.append(1, static_cast<char>('0' + table.accept())).append(table.text()).append("/");
+  if (test == "1ab/2 /1cd/" && table.at_end())
+    std::cout << "OK";
+  else
+    error("interactive scan results");
+  std::cout << std::endl;
+  //
+  FSMMatcher blanks("  ");
+  if (FSMMatcher("abc").matches() && blanks.matches() && blanks.accept() == 2 && !FSMMatcher("ab c").matches())
+    std::cout << "OK";
+  else
+    error("matches results");
+  std::cout << std::endl;
+  //
+  banner("DONE");
+  return 0;
+}